@@ -4,5 +4,5 @@
 
 USER_OBJS :=
 
-LIBS := -lm -lboost_filesystem-mt
+LIBS := -lm -lboost_filesystem-mt -lboost_system-mt -lboost_thread-mt
 
@@ -4,18 +4,63 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+../src/APVArena.cpp \
+../src/APVBinary.cpp \
+../src/APVChunkParser.cpp \
+../src/APVDemux.cpp \
+../src/APVFormat.cpp \
+../src/APVGrid.cpp \
+../src/APVHist.cpp \
+../src/APVKernel.cpp \
+../src/APVPack.cpp \
+../src/APVParser.cpp \
+../src/APVReader.cpp \
 ../src/APVRec.cpp \
+../src/APVStore.cpp \
+../src/APVTrace.cpp \
+../src/APVWriter.cpp \
 ../src/ATimeSpace.cpp \
+../src/pvbench.cpp \
 ../src/pvrec.cpp 
 
 OBJS += \
+./src/APVArena.o \
+./src/APVBinary.o \
+./src/APVChunkParser.o \
+./src/APVDemux.o \
+./src/APVFormat.o \
+./src/APVGrid.o \
+./src/APVHist.o \
+./src/APVKernel.o \
+./src/APVPack.o \
+./src/APVParser.o \
+./src/APVReader.o \
 ./src/APVRec.o \
+./src/APVStore.o \
+./src/APVTrace.o \
+./src/APVWriter.o \
 ./src/ATimeSpace.o \
+./src/pvbench.o \
 ./src/pvrec.o 
 
 CPP_DEPS += \
+./src/APVArena.d \
+./src/APVBinary.d \
+./src/APVChunkParser.d \
+./src/APVDemux.d \
+./src/APVFormat.d \
+./src/APVGrid.d \
+./src/APVHist.d \
+./src/APVKernel.d \
+./src/APVPack.d \
+./src/APVParser.d \
+./src/APVReader.d \
 ./src/APVRec.d \
+./src/APVStore.d \
+./src/APVTrace.d \
+./src/APVWriter.d \
 ./src/ATimeSpace.d \
+./src/pvbench.d \
 ./src/pvrec.d 
 
 
@@ -0,0 +1,87 @@
+/*
+ * @file APVArena.cpp 类APVArena的定义文件
+ * @version 0.1
+ * @date Oct 17, 2026
+ */
+#include <string.h>
+#include "APVArena.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+APVArena::APVArena() {
+	cur_ = end_ = NULL;
+	memset(free_, 0, sizeof(free_));
+}
+
+APVArena::~APVArena() {
+	Reset();
+}
+
+void *APVArena::Allocate(size_t n) {
+	int c = size_class(n);
+	void *p;
+
+	if (c >= NCLASS) {// 大尺寸请求直接向系统申请
+		p = ::operator new(n);
+		stat_.reserved += n;
+		stat_.inuse    += n;
+	}
+	else {
+		size_t bytes = size_t(1) << (c + MIN_SHIFT);
+		if (free_[c]) {// 复用空闲内存
+			p = free_[c];
+			free_[c] = free_[c]->next;
+			++stat_.recycled;
+		}
+		else {
+			if (cur_ + bytes > end_) {// 申请新的内存块. 原内存块剩余空间被放弃
+				cur_ = static_cast<char*>(::operator new(BLOCK_SIZE));
+				end_ = cur_ + BLOCK_SIZE;
+				blocks_.push_back(cur_);
+				stat_.reserved += BLOCK_SIZE;
+			}
+			p = cur_;
+			cur_ += bytes;
+		}
+		stat_.inuse += bytes;
+	}
+	++stat_.allocated;
+	if (stat_.inuse > stat_.peak) stat_.peak = stat_.inuse;
+
+	return p;
+}
+
+void APVArena::Deallocate(void *p, size_t n) {
+	if (!p) return;
+	int c = size_class(n);
+
+	if (c >= NCLASS) {
+		::operator delete(p);
+		stat_.reserved -= n;
+		stat_.inuse    -= n;
+	}
+	else {
+		free_node *node = static_cast<free_node*>(p);
+		node->next = free_[c];
+		free_[c]   = node;
+		stat_.inuse -= size_t(1) << (c + MIN_SHIFT);
+	}
+}
+
+void APVArena::Reset() {
+	for (std::vector<char*>::iterator it = blocks_.begin(); it != blocks_.end(); ++it) {
+		::operator delete(*it);
+	}
+	blocks_.clear();
+	cur_ = end_ = NULL;
+	memset(free_, 0, sizeof(free_));
+	stat_ = PVARENASTAT();
+}
+
+int APVArena::size_class(size_t n) {
+	int c(0);
+	for (n = n ? (n - 1) >> MIN_SHIFT : 0; n; n >>= 1) ++c;
+	return c;
+}
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,144 @@
+/*
+ * @file APVArena.h 类APVArena的声明文件
+ * APVArena -- 批次内存池. 候选体、数据帧及其序号数组在NewSequence()..EndSequence()
+ * 期间从内存池分配, 在NewSequence()中一次性释放
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * - 按2的幂次划分尺寸等级, 释放的内存块进入同等级空闲链表, 供后续分配复用
+ * - 超出最大等级的请求直接向系统申请
+ * - Reset()前, 所有由内存池分配的对象必须已被释放
+ * - 非线程安全: 每个APVRec实例拥有独立的内存池
+ */
+
+#ifndef APVARENA_H_
+#define APVARENA_H_
+
+#include <stddef.h>
+#include <new>
+#include <vector>
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+typedef struct pv_arena_stat {// 内存池统计信息
+	size_t inuse;		//< 在用字节数
+	size_t peak;		//< 在用字节数峰值
+	size_t reserved;	//< 向系统申请的字节数
+	size_t allocated;	//< 分配次数
+	size_t recycled;	//< 由空闲链表满足的分配次数
+
+public:
+	pv_arena_stat() {
+		inuse = peak = reserved = 0;
+		allocated = recycled = 0;
+	}
+}PVARENASTAT;
+
+class APVArena {
+public:
+	APVArena();
+	virtual ~APVArena();
+
+protected:
+	enum {
+		MIN_SHIFT  = 4,			//< 最小等级: 16字节
+		NCLASS     = 13,		//< 等级数量. 最大等级: 64K字节
+		BLOCK_SIZE = 1 << 20	//< 单次向系统申请的字节数
+	};
+
+	struct free_node {
+		free_node *next;
+	};
+
+	std::vector<char*> blocks_;	//< 已申请内存块
+	char *cur_, *end_;			//< 当前内存块的可用区间
+	free_node *free_[NCLASS];	//< 各等级空闲链表
+	PVARENASTAT stat_;			//< 统计信息
+
+public:
+	/*!
+	 * @brief 分配内存
+	 * @param n 字节数
+	 */
+	void *Allocate(size_t n);
+	/*!
+	 * @brief 释放内存, 进入空闲链表
+	 * @param p 内存地址
+	 * @param n 字节数, 与Allocate()一致
+	 */
+	void Deallocate(void *p, size_t n);
+	/*!
+	 * @brief 一次性释放所有内存, 清除统计信息
+	 */
+	void Reset();
+	/*!
+	 * @brief 查看统计信息
+	 */
+	const PVARENASTAT& GetStat() const {
+		return stat_;
+	}
+
+protected:
+	/*!
+	 * @brief 计算字节数对应的等级
+	 */
+	static int size_class(size_t n);
+};
+
+/*!
+ * @class pv_allocator 由APVArena分配内存的STL分配器
+ * @note
+ * 未关联内存池时使用系统分配器
+ */
+template <class T>
+class pv_allocator {
+public:
+	typedef T value_type;
+	typedef T* pointer;
+	typedef const T* const_pointer;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef size_t size_type;
+	typedef ptrdiff_t difference_type;
+
+	template <class U> struct rebind {
+		typedef pv_allocator<U> other;
+	};
+
+	APVArena *arena;	//< 内存池
+
+public:
+	pv_allocator(APVArena *Arena = NULL) {
+		arena = Arena;
+	}
+
+	template <class U>
+	pv_allocator(const pv_allocator<U> &other) {
+		arena = other.arena;
+	}
+
+	T *allocate(size_t n) {
+		size_t bytes = n * sizeof(T);
+		return static_cast<T*>(arena ? arena->Allocate(bytes) : ::operator new(bytes));
+	}
+
+	void deallocate(T *p, size_t n) {
+		if (arena) arena->Deallocate(p, n * sizeof(T));
+		else ::operator delete(p);
+	}
+
+	template <class U>
+	bool operator==(const pv_allocator<U> &other) const {
+		return arena == other.arena;
+	}
+
+	template <class U>
+	bool operator!=(const pv_allocator<U> &other) const {
+		return arena != other.arena;
+	}
+};
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif /* APVARENA_H_ */
@@ -0,0 +1,230 @@
+/*
+ * @file APVBinary.cpp 类APVBinary的定义文件
+ * @version 0.1
+ * @date Oct 17, 2026
+ */
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <boost/static_assert.hpp>
+#include "APVBinary.h"
+#include "APVParser.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+BOOST_STATIC_ASSERT(sizeof(PVBINHEAD) == 64);
+BOOST_STATIC_ASSERT(sizeof(PVBINREC)  == 56);
+BOOST_STATIC_ASSERT(sizeof(PVBINSEQ)  == 32);
+BOOST_STATIC_ASSERT(sizeof(PVBINFRM)  == 32);
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define PVBIN_HOST_OK	false	//< 大端主机
+#else
+#define PVBIN_HOST_OK	true
+#endif
+
+#define PVBIN_BUFSIZE	(1 << 22)	//< 转换时的写缓冲区字节数
+
+/*
+ * @brief 检查区间[first, first + n)是否位于[0, total)之内. 以减法比较, 避免溢出
+ */
+static bool valid_index(uint64_t first, uint64_t n, uint64_t total) {
+	return first <= total && n <= total - first;
+}
+
+/*
+ * @brief 检查以offset起始的n条记录是否位于文件之内. 以除法比较, 避免溢出
+ */
+static bool valid_range(uint64_t offset, uint64_t n, uint64_t recsize, uint64_t size) {
+	return offset <= size && n <= (size - offset) / recsize;
+}
+
+APVBinary::APVBinary() {
+	head_ = NULL;
+	recs_ = NULL;
+	seqs_ = NULL;
+	frms_ = NULL;
+}
+
+APVBinary::~APVBinary() {
+	Close();
+}
+
+bool APVBinary::IsBinary(const char *filepath) {
+	struct stat st;
+	char magic[8];
+	int fd;
+
+	// 仅检查普通文件: 读取管道或FIFO会消耗其中的数据
+	if (stat(filepath, &st) || !S_ISREG(st.st_mode) || st.st_size < off_t(sizeof(PVBINHEAD))) return false;
+	if ((fd = open(filepath, O_RDONLY)) < 0) return false;
+	bool rslt = read(fd, magic, 8) == 8 && memcmp(magic, PVBIN_MAGIC, 8) == 0;
+	close(fd);
+	return rslt;
+}
+
+long APVBinary::Convert(const char *pathRaw, const char *pathBin) {
+	if (!PVBIN_HOST_OK) return -1;
+
+	APVReader reader;
+	APVParser parser;
+	const char *line, *end;
+	if (!reader.Open(pathRaw)) return -2;
+	FILE *fp = fopen(pathBin, "wb");
+	if (!fp) return -3;
+	std::vector<char> buff(PVBIN_BUFSIZE);
+	setvbuf(fp, &buff[0], _IOFBF, buff.size());
+
+	PVBINHEAD head;
+	PVBINREC rec;
+	PVBINSEQ *seq(NULL);
+	PVBINFRM *frm(NULL);
+	std::vector<PVBINSEQ> seqs;
+	std::vector<PVBINFRM> frms;
+	PVPT pt;
+	int camid, rslt;
+	uint64_t nrec(0);
+
+	memset(&head, 0, sizeof(head));
+	fwrite(&head, sizeof(head), 1, fp); // 占位, 完成后重写
+	reader.NextLine(line, end); // 空读一行
+	while (reader.NextLine(line, end)) {
+		if ((rslt = parser.Resolve(line, end, pt, camid)) != APVParser::PARSE_OK) {
+			if (rslt != APVParser::PARSE_BLANK)
+				printf("%s:%d: %s\n", pathRaw, reader.LineNumber(), APVParser::ErrorString(rslt));
+			continue;
+		}
+		if (!seq || seq->camid != camid) {// 新的批次
+			PVBINSEQ s;
+			memset(&s, 0, sizeof(s));
+			s.camid    = camid;
+			s.firstrec = nrec;
+			s.firstfrm = frms.size();
+			seqs.push_back(s);
+			seq = &seqs.back();
+			frm = NULL;
+		}
+		if (!frm || frm->fno != pt.fno) {// 新的帧
+			PVBINFRM f;
+			memset(&f, 0, sizeof(f));
+			f.fno      = pt.fno;
+			f.mjd      = pt.mjd;
+			f.firstrec = nrec;
+			frms.push_back(f);
+			frm = &frms.back();
+			++seq->nfrm;
+		}
+
+		rec.fno   = pt.fno;
+		rec.camid = camid;
+		rec.mjd   = pt.mjd;
+		rec.x     = pt.x;
+		rec.y     = pt.y;
+		rec.ra    = pt.ra;
+		rec.dc    = pt.dc;
+		rec.mag   = pt.mag;
+		fwrite(&rec, sizeof(rec), 1, fp);
+		++seq->nrec;
+		++frm->nrec;
+		++nrec;
+	}
+	reader.Close();
+
+	memcpy(head.magic, PVBIN_MAGIC, 8);
+	head.version = PVBIN_VERSION;
+	head.recsize = sizeof(PVBINREC);
+	head.nrec    = nrec;
+	head.offrec  = sizeof(PVBINHEAD);
+	head.nseq    = seqs.size();
+	head.nfrm    = frms.size();
+	head.offseq  = head.offrec + nrec * sizeof(PVBINREC);
+	head.offfrm  = head.offseq + seqs.size() * sizeof(PVBINSEQ);
+	if (seqs.size()) fwrite(&seqs[0], sizeof(PVBINSEQ), seqs.size(), fp);
+	if (frms.size()) fwrite(&frms[0], sizeof(PVBINFRM), frms.size(), fp);
+	fseek(fp, 0, SEEK_SET);
+	fwrite(&head, sizeof(head), 1, fp);
+	rslt = ferror(fp);
+	if (fclose(fp) || rslt) return -4;
+
+	return long(nrec);
+}
+
+bool APVBinary::Open(const char *filepath) {
+	Close();
+	if (!PVBIN_HOST_OK || !reader_.Open(filepath)) return false;
+	if (!reader_.IsMapped() || reader_.Size() < sizeof(PVBINHEAD)) {// 二进制文件须可映射
+		reader_.Close();
+		return false;
+	}
+
+	const char *base = reader_.Data();
+	uint64_t size = reader_.Size();
+	const PVBINHEAD *head = (const PVBINHEAD*) base;
+	if (memcmp(head->magic, PVBIN_MAGIC, 8) || head->version != PVBIN_VERSION
+			|| head->recsize != sizeof(PVBINREC)
+			|| head->offrec % 8 || head->offseq % 8 || head->offfrm % 8
+			|| !valid_range(head->offrec, head->nrec, sizeof(PVBINREC), size)
+			|| !valid_range(head->offseq, head->nseq, sizeof(PVBINSEQ), size)
+			|| !valid_range(head->offfrm, head->nfrm, sizeof(PVBINFRM), size)) {
+		reader_.Close();
+		return false;
+	}
+
+	const PVBINSEQ *seqs = (const PVBINSEQ*) (base + head->offseq);
+	const PVBINFRM *frms = (const PVBINFRM*) (base + head->offfrm);
+	for (uint32_t i = 0; i < head->nseq; ++i) {// 索引越界的文件视为损坏
+		const PVBINSEQ &seq = seqs[i];
+		bool valid = valid_index(seq.firstrec, seq.nrec, head->nrec)
+				&& valid_index(seq.firstfrm, seq.nfrm, head->nfrm);
+		for (uint64_t j = seq.firstfrm, jend = seq.firstfrm + seq.nfrm; valid && j < jend; ++j) {
+			// 帧的数据点须位于所属批次之内
+			valid = frms[j].firstrec >= seq.firstrec
+					&& valid_index(frms[j].firstrec - seq.firstrec, frms[j].nrec, seq.nrec);
+		}
+		if (!valid) {
+			reader_.Close();
+			return false;
+		}
+	}
+
+	head_ = head;
+	recs_ = (const PVBINREC*) (base + head->offrec);
+	seqs_ = seqs;
+	frms_ = frms;
+	return true;
+}
+
+void APVBinary::Close() {
+	reader_.Close();
+	head_ = NULL;
+	recs_ = NULL;
+	seqs_ = NULL;
+	frms_ = NULL;
+}
+
+void APVBinary::Load(int iseq, std::vector<PVPT> &pts) const {
+	const PVBINSEQ &seq = seqs_[iseq];
+	const PVBINREC *rec = recs_ + seq.firstrec, *recend = rec + seq.nrec;
+	PVPT pt;
+
+	pts.reserve(pts.size() + seq.nrec);
+	for (; rec != recend; ++rec) {
+		ToPoint(*rec, pt);
+		pts.push_back(pt);
+	}
+}
+
+void APVBinary::Load(int iseq, APVRec &rec) const {
+	const PVBINSEQ &seq = seqs_[iseq];
+	const PVBINREC *r = recs_ + seq.firstrec, *rend = r + seq.nrec;
+	PVPT pt;
+
+	for (; r != rend; ++r) {
+		ToPoint(*r, pt);
+		rec.AddPoint(pt);
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,152 @@
+/*
+ * @file APVBinary.h 类APVBinary的声明文件
+ * APVBinary -- 二进制数据点文件. 由文本格式原始文件转换生成, 加载时无需逐行解析
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * 文件格式(版本1), 所有字段均为小端字节序, 各区按8字节对齐:
+ * - 文件头:   PVBINHEAD, 64字节
+ * - 数据点区: PVBINREC数组, 每条56字节. 按原始文件次序存储, 不含格式错误的行
+ * - 批次索引: PVBINSEQ数组. 原始文件中相机编号连续相同的数据构成一个批次
+ * - 帧索引:   PVBINFRM数组. 批次中帧编号连续相同的数据构成一帧
+ *
+ * @note
+ * - 加载时以mmap()映射文件, 数据点直接引用映射内存
+ * - 大端主机不支持此格式, Open()及Convert()返回失败
+ */
+
+#ifndef APVBINARY_H_
+#define APVBINARY_H_
+
+#include <stdint.h>
+#include <vector>
+#include "APVRec.h"
+#include "APVReader.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+#define PVBIN_MAGIC		"PVRECBIN"	//< 文件标志
+#define PVBIN_VERSION	1			//< 格式版本
+
+typedef struct pv_binhead {// 文件头
+	char magic[8];		//< 文件标志, PVBIN_MAGIC
+	uint32_t version;	//< 格式版本
+	uint32_t recsize;	//< 单条数据点记录的字节数
+	uint64_t nrec;		//< 数据点数量
+	uint64_t offrec;	//< 数据点区偏移量
+	uint32_t nseq;		//< 批次数量
+	uint32_t nfrm;		//< 帧数量
+	uint64_t offseq;	//< 批次索引偏移量
+	uint64_t offfrm;	//< 帧索引偏移量
+	uint64_t reserved;	//< 保留
+}PVBINHEAD;
+
+typedef struct pv_binrec {// 数据点记录
+	int32_t fno;	//< 帧编号
+	int32_t camid;	//< 相机编号
+	double mjd;		//< 曝光中间时间对应的修正儒略日
+	double x, y;	//< 星象质心在模板中的位置
+	double ra, dc;	//< 赤道坐标, 量纲: 角度
+	double mag;		//< 星等
+}PVBINREC;
+
+typedef struct pv_binseq {// 批次索引
+	int32_t camid;		//< 相机编号
+	uint32_t nfrm;		//< 帧数量
+	uint64_t firstrec;	//< 首个数据点在数据点区中的序号
+	uint64_t nrec;		//< 数据点数量
+	uint64_t firstfrm;	//< 首帧在帧索引中的序号
+}PVBINSEQ;
+
+typedef struct pv_binfrm {// 帧索引
+	int32_t fno;		//< 帧编号
+	uint32_t reserved;	//< 保留
+	double mjd;			//< 首个数据点的修正儒略日
+	uint64_t firstrec;	//< 首个数据点在数据点区中的序号
+	uint64_t nrec;		//< 数据点数量
+}PVBINFRM;
+
+class APVBinary {
+public:
+	APVBinary();
+	virtual ~APVBinary();
+
+protected:
+	APVReader reader_;		//< 文件映射
+	const PVBINHEAD *head_;	//< 文件头
+	const PVBINREC *recs_;	//< 数据点区
+	const PVBINSEQ *seqs_;	//< 批次索引
+	const PVBINFRM *frms_;	//< 帧索引
+
+public:
+	/*!
+	 * @brief 检查文件是否为二进制数据点文件. 管道、FIFO等非普通文件不读取, 返回false
+	 */
+	static bool IsBinary(const char *filepath);
+	/*!
+	 * @brief 将文本格式原始文件转换为二进制数据点文件
+	 * @param pathRaw 原始文件路径
+	 * @param pathBin 二进制文件路径
+	 * @return
+	 * 数据点数量. 失败时为负数
+	 */
+	static long Convert(const char *pathRaw, const char *pathBin);
+	/*!
+	 * @brief 打开并映射二进制文件, 检查格式版本及索引的有效性
+	 */
+	bool Open(const char *filepath);
+	/*!
+	 * @brief 关闭文件
+	 */
+	void Close();
+	/*!
+	 * @brief 批次数量
+	 */
+	int SequenceCount() const {
+		return head_ ? int(head_->nseq) : 0;
+	}
+	/*!
+	 * @brief 查看批次索引
+	 */
+	const PVBINSEQ &Sequence(int iseq) const {
+		return seqs_[iseq];
+	}
+	/*!
+	 * @brief 查看批次的帧索引, 共Sequence(iseq).nfrm项
+	 */
+	const PVBINFRM *Frames(int iseq) const {
+		return frms_ + seqs_[iseq].firstfrm;
+	}
+	/*!
+	 * @brief 查看数据点记录
+	 * @param first 首个数据点的序号, 见PVBINSEQ::firstrec和PVBINFRM::firstrec
+	 */
+	const PVBINREC *Records(uint64_t first = 0) const {
+		return recs_ + first;
+	}
+	/*!
+	 * @brief 将数据点记录转换为数据点
+	 */
+	static void ToPoint(const PVBINREC &rec, PVPT &pt) {
+		pt.fno = rec.fno;
+		pt.mjd = rec.mjd;
+		pt.x   = rec.x;
+		pt.y   = rec.y;
+		pt.ra  = rec.ra;
+		pt.dc  = rec.dc;
+		pt.mag = rec.mag;
+	}
+	/*!
+	 * @brief 将一个批次的数据点追加至数组
+	 */
+	void Load(int iseq, std::vector<PVPT> &pts) const;
+	/*!
+	 * @brief 将一个批次的数据点依次导入APVRec, 不调用NewSequence()和EndSequence()
+	 */
+	void Load(int iseq, APVRec &rec) const;
+};
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif /* APVBINARY_H_ */
@@ -0,0 +1,151 @@
+/*
+ * @file APVChannel.h 类APVChannel的声明文件
+ * APVChannel -- 流水线阶段之间的有界单生产者/单消费者无锁队列, 统计队列深度与等待
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * 使用流程:
+ * (1) APVChannel(), 指定名称及容量
+ * (2) Push(),       生产者线程写入一个元素. 队列已满时等待
+ * (3) Pop(),        消费者线程取出一个元素. 队列为空时等待, 关闭且为空时返回false
+ * (4) Close(),      生产者写入最后一个元素后关闭队列
+ *
+ * @note
+ * - 同一时刻仅允许一个生产者线程与一个消费者线程
+ * - 等待时依次自旋、让出时间片、短暂休眠, 不使用互斥锁与条件变量
+ * - 生产者更新写入次数、队列深度与写入等待; 消费者更新读取等待. 二者互不共享计数,
+ *   因此Stat()应在生产者与消费者线程结束后调用, 否则仅为近似值
+ */
+
+#ifndef APVCHANNEL_H_
+#define APVCHANNEL_H_
+
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <boost/atomic.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+typedef struct pv_channel_stat {// 队列统计
+	const char *name;	//< 队列名称
+	int capacity;		//< 容量
+	unsigned long pushed;	//< 写入次数
+	unsigned long depthmax;	//< 写入时的最大队列深度
+	double depthsum;		//< 写入时的队列深度累加值
+	unsigned long fullstall;	//< 生产者因队列已满而等待的次数
+	unsigned long emptystall;	//< 消费者因队列为空而等待的次数
+	double fullwait;	//< 生产者累计等待时间, 量纲: 秒
+	double emptywait;	//< 消费者累计等待时间, 量纲: 秒
+
+public:
+	double DepthMean() const {
+		return pushed ? depthsum / pushed : 0.0;
+	}
+}PVCHANSTAT;
+
+/*
+ * @brief 单调时钟, 量纲: 秒
+ */
+inline double pv_channel_now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1E-9;
+}
+
+/*
+ * @brief 等待退避: 先自旋, 再让出时间片, 最后休眠. 休眠时长每64轮加倍, 最长1毫秒,
+ * 避免长时间等待的线程频繁唤醒而与工作线程争用处理器
+ * @param n 已等待的轮数
+ */
+inline void pv_channel_backoff(int n) {
+	if (n < 64) return;
+	if (n < 128) boost::this_thread::yield();
+	else {
+		int k = (n - 128) / 64;
+		usleep(k < 6 ? 20 << k : 1000);
+	}
+}
+
+template <class T>
+class APVChannel {
+public:
+	/*!
+	 * @param name     队列名称, 静态字符串
+	 * @param capacity 容量
+	 */
+	APVChannel(const char *name, int capacity)
+		: queue_(capacity < 1 ? 1 : capacity) {
+		closed_ = false;
+		memset(&stat_, 0, sizeof(PVCHANSTAT));
+		stat_.name     = name;
+		stat_.capacity = capacity < 1 ? 1 : capacity;
+	}
+
+	virtual ~APVChannel() {
+	}
+
+protected:
+	boost::lockfree::spsc_queue<T> queue_;	//< 环形缓冲区
+	boost::atomic<bool> closed_;	//< 关闭标志
+	PVCHANSTAT stat_;		//< 统计
+
+public:
+	/*!
+	 * @brief 写入一个元素. 队列已满时等待. 仅由生产者线程调用
+	 */
+	void Push(const T &x) {
+		unsigned long depth = stat_.capacity - queue_.write_available();	// read_available()仅限消费者调用
+		if (depth > stat_.depthmax) stat_.depthmax = depth;
+		stat_.depthsum += depth;
+		++stat_.pushed;
+		if (queue_.push(x)) return;
+
+		double t0 = pv_channel_now();
+		int n(0);
+		++stat_.fullstall;
+		while (!queue_.push(x)) pv_channel_backoff(n++);
+		stat_.fullwait += pv_channel_now() - t0;
+	}
+	/*!
+	 * @brief 取出一个元素. 队列为空时等待. 仅由消费者线程调用
+	 * @return
+	 * 队列已关闭且为空时返回false
+	 */
+	bool Pop(T &x) {
+		if (queue_.pop(x)) return true;
+
+		double t0 = pv_channel_now();
+		int n(0);
+		bool rslt(true);
+		++stat_.emptystall;
+		while (!queue_.pop(x)) {
+			if (closed_.load(boost::memory_order_acquire)) {// 关闭前写入的元素此时均可见
+				rslt = queue_.pop(x);
+				break;
+			}
+			pv_channel_backoff(n++);
+		}
+		stat_.emptywait += pv_channel_now() - t0;
+		return rslt;
+	}
+	/*!
+	 * @brief 关闭队列: 不再写入. 由生产者线程调用
+	 */
+	void Close() {
+		closed_.store(true, boost::memory_order_release);
+	}
+	/*!
+	 * @brief 查看统计
+	 */
+	const PVCHANSTAT &Stat() const {
+		return stat_;
+	}
+};
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif /* APVCHANNEL_H_ */
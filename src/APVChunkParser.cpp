@@ -0,0 +1,154 @@
+/*
+ * @file APVChunkParser.cpp 类APVChunkParser的定义文件
+ * @version 0.1
+ * @date Oct 17, 2026
+ */
+#include <string.h>
+#include <boost/bind/bind.hpp>
+#include <boost/make_shared.hpp>
+#include "APVChunkParser.h"
+#include "APVTrace.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+APVChunkParser::APVChunkParser(int nthread, size_t chunksize) {
+	nthread_   = nthread < 1 ? 1 : nthread;
+	chunksize_ = chunksize < 1024 ? 1024 : chunksize;
+	data_      = NULL;
+	begin_     = size_ = 0;
+	nchunk_    = next_ = consumed_ = 0;
+	lineno_    = 0;
+	stop_      = false;
+}
+
+APVChunkParser::~APVChunkParser() {
+	Close();
+}
+
+bool APVChunkParser::Open(const char *filepath) {
+	const char *line, *end;
+
+	Close();
+	if (!reader_.Open(filepath)) return false;
+	if (!reader_.IsMapped()) {
+		reader_.Close();
+		return false;
+	}
+	data_ = reader_.Data();
+	size_ = reader_.Size();
+	reader_.NextLine(line, end); // 空读一行
+	begin_  = reader_.NextLine(line, end) ? line - data_ : size_;
+	nchunk_ = (size_ - begin_ + chunksize_ - 1) / chunksize_;
+	lineno_ = 1;
+	stop_   = false;
+
+	slots_.resize(2 * nthread_);
+	for (std::vector<PPVCHUNK>::iterator it = slots_.begin(); it != slots_.end(); ++it) {
+		*it = boost::make_shared<PVCHUNK>();
+		(*it)->done = false;
+	}
+	for (int i = 0; i < nthread_; ++i)
+		threads_.create_thread(boost::bind(&APVChunkParser::thread_parse, this));
+	return true;
+}
+
+void APVChunkParser::Close() {
+	{
+		boost::mutex::scoped_lock lck(mtx_);
+		stop_ = true;
+	}
+	cvslot_.notify_all();
+	threads_.join_all();
+	reader_.Close();
+	slots_.clear();
+	data_   = NULL;
+	begin_  = size_ = 0;
+	nchunk_ = next_ = consumed_ = 0;
+	lineno_ = 0;
+}
+
+const PVCHUNK *APVChunkParser::Next() {
+	boost::mutex::scoped_lock lck(mtx_);
+	int nslot = slots_.size();
+
+	if (consumed_ > 0) {// 释放上次取回的区间
+		PVCHUNK &last = *slots_[(consumed_ - 1) % nslot];
+		last.done = false;
+		cvslot_.notify_all();
+	}
+	if (consumed_ >= nchunk_) return NULL;
+
+	PVCHUNK &chunk = *slots_[consumed_ % nslot];
+	while (!chunk.done) cvdone_.wait(lck);
+	++consumed_;
+	// 区间行号换算为文件行号
+	for (std::vector<std::pair<int, int> >::iterator it = chunk.errs.begin(); it != chunk.errs.end(); ++it)
+		it->first += lineno_;
+	lineno_ += chunk.lines;
+	return &chunk;
+}
+
+size_t APVChunkParser::chunk_begin(int k) {
+	if (k <= 0) return begin_;
+	if (k >= nchunk_) return size_;
+	// 名义边界前一字节为换行符时, 名义边界即行首
+	size_t pos = begin_ + k * chunksize_ - 1;
+	const char *p = (const char*) memchr(data_ + pos, '\n', size_ - pos);
+	return p ? p - data_ + 1 : size_;
+}
+
+void APVChunkParser::parse(APVParser &parser, int k, PVCHUNK &chunk) {
+	APVTraceScope trace("parse_chunk", -1, k);
+	const char *line = data_ + chunk_begin(k);
+	const char *last = data_ + chunk_begin(k + 1);
+	const char *end;
+	int camid, rslt;
+	PVPT pt;
+
+	chunk.pts.clear();
+	chunk.cams.clear();
+	chunk.errs.clear();
+	chunk.lines = 0;
+	while (line < last) {// 与APVReader::NextLine()相同的分行规则
+		if (!(end = (const char*) memchr(line, '\n', last - line))) end = last;
+		++chunk.lines;
+		if ((rslt = parser.Resolve(line, end, pt, camid)) == APVParser::PARSE_OK) {
+			chunk.pts.push_back(pt);
+			chunk.cams.push_back(camid);
+		}
+		else if (rslt != APVParser::PARSE_BLANK)
+			chunk.errs.push_back(std::make_pair(chunk.lines, rslt));
+		line = end < last ? end + 1 : last;
+	}
+}
+
+void APVChunkParser::thread_parse() {
+	APVParser parser;
+	int k, nslot;
+	PPVCHUNK chunk;
+
+	APVTrace::SetThreadName("parser");
+
+	while (true) {
+		{// 领取下一个区间. 窗口已满时等待取回
+			boost::mutex::scoped_lock lck(mtx_);
+			nslot = slots_.size();
+			while (!stop_ && next_ < nchunk_ && next_ - consumed_ >= nslot) cvslot_.wait(lck);
+			if (stop_ || next_ >= nchunk_) break;
+			k = next_++;
+			chunk = slots_[k % nslot];
+			// 调用线程仍在使用窗口位置中的前一轮区间时, 等待其释放
+			while (!stop_ && chunk->done) cvslot_.wait(lck);
+			if (stop_) break;
+		}
+		parse(parser, k, *chunk);
+		{
+			boost::mutex::scoped_lock lck(mtx_);
+			chunk->done = true;
+		}
+		cvdone_.notify_all();
+		chunk.reset();
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+}
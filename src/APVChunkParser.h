@@ -0,0 +1,113 @@
+/*
+ * @file APVChunkParser.h 类APVChunkParser的声明文件
+ * APVChunkParser -- 单个原始文件的并行解析. 按行边界将映射文件划分为字节区间,
+ * 由多个线程并行解析, 再按文件次序交付
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * 使用流程:
+ * (1) APVChunkParser(), 指定解析线程数量与区间字节数
+ * (2) Open(),  打开原始文件. 仅支持可映射的普通文件, 失败时应改用APVReader逐行解析
+ * (3) Next(),  按文件次序取回已解析的区间, 至返回NULL
+ * (4) Close(), 关闭文件, 停止解析线程
+ *
+ * @note
+ * - 区间划分: 名义边界为数据起始位置加区间字节数的整数倍, 某行属于其首字节所在的区间.
+ *   各线程独立定位区间边界, 无需预先扫描文件
+ * - 第一行为注释, 不属于任何区间. 区间内的行号自1开始, Next()输出时换算为文件行号
+ * - 同时解析或待取回的区间数量不超过线程数量的2倍, 内存占用与文件大小无关
+ * - 每个线程使用独立的APVParser. 解析结果及错误报告与单线程逐行解析逐位一致
+ */
+
+#ifndef APVCHUNKPARSER_H_
+#define APVCHUNKPARSER_H_
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include "APVReader.h"
+#include "APVParser.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+typedef struct pv_chunk {// 一个区间的解析结果
+	std::vector<PVPT> pts;	//< 数据点
+	std::vector<int> cams;	//< 数据点的相机编号, 与pts一一对应
+	std::vector<std::pair<int, int> > errs;	//< 格式错误: 文件行号与错误代码
+	int lines;		//< 区间内的行数
+	bool done;		//< 解析完成标志
+}PVCHUNK;
+typedef boost::shared_ptr<PVCHUNK> PPVCHUNK;
+
+class APVChunkParser {
+public:
+	/*!
+	 * @param nthread   解析线程数量
+	 * @param chunksize 区间字节数
+	 */
+	APVChunkParser(int nthread, size_t chunksize = CHUNK_SIZE);
+	virtual ~APVChunkParser();
+
+public:
+	enum {
+		CHUNK_SIZE = 4 << 20	//< 缺省区间字节数
+	};
+
+protected:
+	int nthread_;		//< 解析线程数量
+	size_t chunksize_;	//< 区间字节数
+	APVReader reader_;	//< 文件映射
+	const char *data_;	//< 文件内容
+	size_t begin_;		//< 数据起始位置: 第一行之后
+	size_t size_;		//< 文件字节数
+	int nchunk_;		//< 区间数量
+	std::vector<PPVCHUNK> slots_;	//< 环形窗口: 区间k存储于k % slots_.size()
+	int next_;			//< 下一个待解析的区间
+	int consumed_;		//< 已取回的区间数量
+	int lineno_;		//< 已取回区间的最后文件行号
+	boost::thread_group threads_;	//< 解析线程
+	boost::mutex mtx_;	//< 互斥锁
+	boost::condition_variable cvslot_;	//< 条件变量: 窗口中有空闲位置
+	boost::condition_variable cvdone_;	//< 条件变量: 区间解析完成
+	bool stop_;			//< 停止标志
+
+public:
+	/*!
+	 * @brief 打开原始文件并开始解析
+	 * @return
+	 * 打开结果. 文件不可映射(管道、FIFO、标准输入)时返回false
+	 */
+	bool Open(const char *filepath);
+	/*!
+	 * @brief 关闭文件, 停止解析线程
+	 */
+	void Close();
+	/*!
+	 * @brief 按文件次序取回下一个区间. 等待其解析完成
+	 * @return
+	 * 区间解析结果, 行号已换算为文件行号. 在下次调用Next()或Close()前有效.
+	 * 所有区间已取回时返回NULL
+	 */
+	const PVCHUNK *Next();
+
+protected:
+	/*!
+	 * @brief 区间k的起始位置: 名义边界之后的第一个行首
+	 */
+	size_t chunk_begin(int k);
+	/*!
+	 * @brief 解析一个区间
+	 */
+	void parse(APVParser &parser, int k, PVCHUNK &chunk);
+	/*!
+	 * @brief 解析线程
+	 */
+	void thread_parse();
+};
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif /* APVCHUNKPARSER_H_ */
@@ -0,0 +1,237 @@
+/*
+ * @file APVDemux.cpp 类APVDemux的定义文件
+ * @version 0.1
+ * @date Oct 17, 2026
+ */
+#include <algorithm>
+#include <boost/bind/bind.hpp>
+#include <boost/make_shared.hpp>
+#include "ADefine.h"
+#include "APVDemux.h"
+#include "APVTrace.h"
+
+using namespace boost::placeholders;
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+APVDemux::APVDemux(int nthread, const param_pv &param, double idle) {
+	param_   = param;
+	idle_    = idle > 0.0 ? idle / DAYSEC : 0.0;
+	serial_  = 0;
+	next_    = 0;
+	mjdnow_  = 0.0;
+	lastcam_ = -1;
+	camlast_ = NULL;
+	stop_    = false;
+	if (nthread < 2) workers_.push_back(boost::make_shared<demux_worker>());
+	else {
+		for (int i = 0; i < nthread; ++i) {
+			workers_.push_back(boost::make_shared<demux_worker>());
+			threads_.create_thread(boost::bind(&APVDemux::thread_work, this, workers_[i].get()));
+		}
+	}
+}
+
+APVDemux::~APVDemux() {
+	{
+		boost::mutex::scoped_lock lck(mtx_);
+		stop_ = true;
+	}
+	for (std::vector<PWORKER>::iterator it = workers_.begin(); it != workers_.end(); ++it)
+		(*it)->cvjob.notify_all();
+	threads_.join_all();
+}
+
+void APVDemux::RegisterObject(const PVObjSlot &slot) {
+	sigobj_.connect(slot);
+}
+
+int APVDemux::AddPoint(int camid, const PVPT &pt) {
+	int n(0);
+
+	if (pt.mjd > mjdnow_) {// 数据时间前进时检查空闲相机
+		mjdnow_ = pt.mjd;
+		if (idle_ > 0.0) n = end_idle();
+	}
+	if (camid != lastcam_ || !camlast_) {
+		CAMMAP::iterator it = cams_.find(camid);
+		camlast_ = it != cams_.end() ? &it->second : &start_camera(camid);
+		lastcam_ = camid;
+	}
+
+	demux_camera &cam = *camlast_;
+	cam.lastmjd = pt.mjd;
+	if (cam.rec) cam.rec->AddPoint(pt);
+	else {
+		cam.job->pts.push_back(pt);
+		if (cam.job->pts.size() >= BATCH_SIZE) submit(cam);
+	}
+	return n;
+}
+
+int APVDemux::End() {
+	std::vector<std::pair<long, int> > order;
+	int n = cams_.size();
+
+	for (CAMMAP::iterator it = cams_.begin(); it != cams_.end(); ++it)
+		order.push_back(std::make_pair(it->second.serial, it->first));
+	std::sort(order.begin(), order.end());
+	for (int i = 0; i < n; ++i) end_camera(cams_.find(order[i].second));
+	return n;
+}
+
+PPVSEQ APVDemux::Next(bool wait) {
+	boost::mutex::scoped_lock lck(mtx_);
+	PPVSEQ seq;
+
+	if (pending_.size()) {
+		if (wait) {
+			while (!pending_.front()->done) cvdone_.wait(lck);
+		}
+		if (pending_.front()->done) {
+			seq = pending_.front();
+			pending_.pop_front();
+		}
+	}
+	return seq;
+}
+
+APVDemux::demux_camera &APVDemux::start_camera(int camid) {
+	demux_camera &cam = cams_[camid];
+
+	cam.worker  = threads_.size() ? next_++ % workers_.size() : 0;
+	cam.serial  = serial_++;
+	cam.lastmjd = 0.0;
+	if (threads_.size()) {
+		cam.rec = NULL;
+		cam.job = boost::make_shared<demux_job>();
+		cam.job->camid = camid;
+		cam.job->seq   = boost::make_shared<PVSEQ>(camid);
+		cam.job->end   = false;
+		cam.job->pts.reserve(BATCH_SIZE);
+	}
+	else cam.rec = &recognizer(*workers_[0], camid);
+	return cam;
+}
+
+void APVDemux::end_camera(CAMMAP::iterator it) {
+	demux_camera &cam = it->second;
+
+	if (!cam.job.use_count()) {// 单线程: 仅需要结束批次
+		cam.job = boost::make_shared<demux_job>();
+		cam.job->camid = it->first;
+		cam.job->seq   = boost::make_shared<PVSEQ>(it->first);
+	}
+	cam.job->end = true;
+	{
+		boost::mutex::scoped_lock lck(mtx_);
+		pending_.push_back(cam.job->seq);
+	}
+	submit(cam);
+	if (camlast_ == &cam) camlast_ = NULL;
+	cams_.erase(it);
+}
+
+int APVDemux::end_idle() {
+	std::vector<std::pair<long, int> > order;
+	int n;
+
+	for (CAMMAP::iterator it = cams_.begin(); it != cams_.end(); ++it) {
+		if (mjdnow_ - it->second.lastmjd > idle_)
+			order.push_back(std::make_pair(it->second.serial, it->first));
+	}
+	if (!(n = order.size())) return 0;
+	std::sort(order.begin(), order.end());
+	for (int i = 0; i < n; ++i) end_camera(cams_.find(order[i].second));
+	return n;
+}
+
+void APVDemux::submit(demux_camera &cam) {
+	PJOB job = cam.job;
+	demux_worker &worker = *workers_[cam.worker];
+
+	if (!threads_.size()) {
+		process(worker, job);
+		cam.job.reset();
+		return;
+	}
+
+	{
+		boost::mutex::scoped_lock lck(mtx_);
+		while (int(worker.jobs.size()) >= MAX_JOBS) cvdone_.wait(lck);
+		worker.jobs.push_back(job);
+	}
+	worker.cvjob.notify_one();
+	if (!job->end) {// 继续累积同一批次的数据点
+		cam.job = boost::make_shared<demux_job>();
+		cam.job->camid = job->camid;
+		cam.job->seq   = job->seq;
+		cam.job->end   = false;
+		cam.job->pts.reserve(BATCH_SIZE);
+	}
+}
+
+void APVDemux::process(demux_worker &worker, const PJOB &job) {
+	APVRec &pvrec = recognizer(worker, job->camid);
+	for (std::vector<PVPT>::iterator it = job->pts.begin(); it != job->pts.end(); ++it)
+		pvrec.AddPoint(*it);
+	if (!job->end) return;
+
+	PVSEQ &seq = *job->seq;
+	int camid;
+	pvrec.EndSequence();
+	seq.objs.swap(pvrec.GetObject(camid));
+	seq.prof = pvrec.GetProfile();
+	seq.lat  = pvrec.GetLatency();
+	// 识别实例留待其它相机批次复用
+	boost::unordered_map<int, PAPVREC>::iterator it = worker.recs.find(job->camid);
+	worker.spare.push_back(it->second);
+	worker.recs.erase(it);
+	{
+		boost::mutex::scoped_lock lck(mtx_);
+		seq.done = true;
+	}
+	cvdone_.notify_all();
+}
+
+APVRec &APVDemux::recognizer(demux_worker &worker, int camid) {
+	PAPVREC &pvrec = worker.recs[camid];
+	if (!pvrec.use_count()) {
+		if (worker.spare.size()) {
+			pvrec = worker.spare.back();
+			worker.spare.pop_back();
+		}
+		else {
+			pvrec = boost::make_shared<APVRec>();
+			if (!sigobj_.empty()) pvrec->RegisterObject(boost::bind(&APVDemux::on_object, this, _1, _2));
+		}
+		pvrec->SetParam(param_);
+		pvrec->NewSequence(camid);
+	}
+	return *pvrec;
+}
+
+void APVDemux::on_object(int camid, const PPVOBJ &obj) {
+	sigobj_(camid, obj);
+}
+
+void APVDemux::thread_work(demux_worker *worker) {
+	PJOB job;
+
+	APVTrace::SetThreadName("recognizer");
+
+	while (true) {
+		{
+			boost::mutex::scoped_lock lck(mtx_);
+			while (!stop_ && !worker->jobs.size()) worker->cvjob.wait(lck);
+			if (!worker->jobs.size()) break;	// 停止前处理所有剩余任务
+			job = worker->jobs.front();
+			worker->jobs.pop_front();
+		}
+		cvdone_.notify_all();	// 等待交付任务的调用线程
+		process(*worker, job);
+		job.reset();
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,191 @@
+/*
+ * @file APVDemux.h 类APVDemux的声明文件
+ * APVDemux -- 相机分流. 为每个相机维护一个持续工作的APVRec, 按相机编号分发数据点
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * 使用流程:
+ * (1) APVDemux(), 指定工作线程数量与空闲时限. 线程数量小于2时在调用线程中直接识别
+ * (2) AddPoint(), 分发一个数据点. 不同相机的数据点可以交错
+ * (3) End(),      输入结束, 结束所有相机批次
+ * (4) Next(),     按批次结束次序取回已完成识别的批次
+ *
+ * @note
+ * - 相机批次仅在输入结束或空闲超时时结束. 相机编号变化不再结束批次
+ * - 空闲时限以数据时间计: 最新数据点时标与该相机最后数据点时标之差大于时限时结束该相机批次
+ * - 多线程时, 相机在首次出现时按轮转次序绑定至工作线程, 同一相机的数据点由同一线程按序识别
+ * - Next()严格按批次结束次序返回, 输入结束时各相机按首次出现次序结束.
+ *   因此输出文件命名及目标编号与线程数量无关
+ */
+
+#ifndef APVDEMUX_H_
+#define APVDEMUX_H_
+
+#include <vector>
+#include <boost/unordered_map.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/container/deque.hpp>
+#include "APVRec.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+typedef struct pv_sequence {// 一个相机批次的识别结果
+	int camid;		//< 相机编号
+	PPVOBJVEC objs;	//< 识别目标. 注册回调函数时为空
+	PVPROFILE prof;	//< 性能分析数据, 见APVRec::GetProfile()
+	PVLATENCY lat;	//< 单帧处理延迟, 见APVRec::GetLatency()
+	bool done;		//< 识别完成标志
+
+public:
+	pv_sequence(int Camid = -1) {
+		camid = Camid;
+		done  = false;
+	}
+}PVSEQ;
+typedef boost::shared_ptr<PVSEQ> PPVSEQ;
+typedef boost::container::deque<PPVSEQ> PPVSEQDQ;
+
+typedef boost::shared_ptr<APVRec> PAPVREC;
+
+class APVDemux {
+public:
+	/*!
+	 * @param nthread 工作线程数量
+	 * @param param   数据处理参数
+	 * @param idle    空闲时限, 量纲: 秒. 0: 仅在输入结束时结束批次
+	 */
+	APVDemux(int nthread, const param_pv &param, double idle = 0.0);
+	virtual ~APVDemux();
+
+protected:
+	enum {
+		BATCH_SIZE = 4096,	//< 多线程时单次交付工作线程的数据点数量
+		MAX_JOBS   = 16		//< 多线程时单个工作线程的最大待处理任务数量
+	};
+
+	/*
+	 * @brief 交付工作线程的任务: 同一相机的一组数据点, 可附带结束批次
+	 */
+	struct demux_job {
+		int camid;		//< 相机编号
+		PPVSEQ seq;		//< 批次识别结果
+		std::vector<PVPT> pts;	//< 数据点
+		bool end;		//< 处理数据点后结束批次
+	};
+	typedef boost::shared_ptr<demux_job> PJOB;
+
+	/*
+	 * @brief 工作线程及其负责相机的识别实例
+	 */
+	struct demux_worker {
+		boost::unordered_map<int, PAPVREC> recs;	//< 相机编号 -> 识别实例
+		std::vector<PAPVREC> spare;	//< 批次结束后待复用的识别实例
+		boost::container::deque<PJOB> jobs;	//< 待处理任务
+		boost::condition_variable cvjob;	//< 条件变量: 新的任务
+	};
+	typedef boost::shared_ptr<demux_worker> PWORKER;
+
+	/*
+	 * @brief 调用线程维护的相机状态
+	 */
+	struct demux_camera {
+		int worker;		//< 工作线程序号
+		long serial;	//< 批次开始次序
+		double lastmjd;	//< 最后数据点时标
+		PJOB job;		//< 正在累积的任务. 仅用于多线程
+		APVRec *rec;	//< 识别实例. 仅用于单线程
+	};
+	typedef boost::unordered_map<int, demux_camera> CAMMAP;
+
+	param_pv param_;		//< 数据处理参数
+	double idle_;			//< 空闲时限, 量纲: 天
+	std::vector<PWORKER> workers_;	//< 工作线程状态. 单线程时仅一项, 由调用线程使用
+	boost::thread_group threads_;	//< 工作线程
+	boost::mutex mtx_;		//< 互斥锁
+	boost::condition_variable cvdone_;	//< 条件变量: 任务完成或批次识别完成
+	PPVSEQDQ pending_;		//< 未取回的批次, 按结束次序排列
+	CAMMAP cams_;			//< 活动相机
+	long serial_;			//< 批次开始计数
+	int next_;				//< 下一个绑定的工作线程
+	double mjdnow_;			//< 最新数据点时标
+	int lastcam_;			//< 最近数据点的相机编号
+	demux_camera *camlast_;	//< 最近数据点的相机状态. 相机批次结束后为空
+	PVObjSignal sigobj_;	//< 回调函数: 识别出一个目标
+	bool stop_;				//< 停止标志
+
+public:
+	/*!
+	 * @brief 注册回调函数: 识别出一个目标
+	 * @note
+	 * 应在AddPoint()之前调用. 多线程时回调函数在工作线程中执行
+	 */
+	void RegisterObject(const PVObjSlot &slot);
+	/*!
+	 * @brief 分发一个数据点
+	 * @return
+	 * 本次调用中因空闲超时而结束的批次数量
+	 */
+	int AddPoint(int camid, const PVPT &pt);
+	/*!
+	 * @brief 输入结束, 按首次出现次序结束所有相机批次
+	 * @return
+	 * 结束的批次数量
+	 */
+	int End();
+	/*!
+	 * @brief 按结束次序取回识别完成的批次
+	 * @param wait 最早结束的批次未完成时是否等待
+	 * @return
+	 * 识别完成的批次. 无可取回批次时为空指针
+	 */
+	PPVSEQ Next(bool wait);
+	/*!
+	 * @brief 活动相机数量
+	 */
+	int Live() {
+		return cams_.size();
+	}
+
+protected:
+	/*!
+	 * @brief 开始一个相机批次
+	 */
+	demux_camera &start_camera(int camid);
+	/*!
+	 * @brief 结束一个相机批次. 调用后camera失效
+	 */
+	void end_camera(CAMMAP::iterator it);
+	/*!
+	 * @brief 结束空闲超时的相机批次
+	 * @return
+	 * 结束的批次数量
+	 */
+	int end_idle();
+	/*!
+	 * @brief 将累积的任务交付工作线程. 单线程时直接处理
+	 */
+	void submit(demux_camera &cam);
+	/*!
+	 * @brief 执行一个任务
+	 */
+	void process(demux_worker &worker, const PJOB &job);
+	/*!
+	 * @brief 取得相机的识别实例, 无则新建或复用
+	 */
+	APVRec &recognizer(demux_worker &worker, int camid);
+	/*!
+	 * @brief 识别实例的回调函数: 转发至注册的回调函数
+	 */
+	void on_object(int camid, const PPVOBJ &obj);
+	/*!
+	 * @brief 工作线程
+	 */
+	void thread_work(demux_worker *worker);
+};
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif /* APVDEMUX_H_ */
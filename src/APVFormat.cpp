@@ -0,0 +1,131 @@
+/*
+ * @file APVFormat.cpp 类APVFormat的定义文件
+ * @version 0.1
+ * @date Oct 17, 2026
+ */
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+#include "APVFormat.h"
+#include "ATimeSpace.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+APVFormat::APVFormat() {
+	size_ = 0;
+	jdn_  = 0x7FFFFFFF;
+	iy_ = im_ = id_ = 0;
+}
+
+APVFormat::~APVFormat() {
+}
+
+void APVFormat::Object(const PVOBJ &obj) {
+	for (PPVPTVEC::const_iterator it = obj.pts.begin(); it != obj.pts.end(); ++it) Row(**it);
+}
+
+void APVFormat::Row(const PVPT &pt) {
+	int iy, im, id, hh, mm;
+	double fd, ss;
+
+	if (buff_.size() < size_ + ROW_MAX) buff_.resize(2 * (size_ + ROW_MAX));
+	Date(pt.mjd, iy, im, id, fd);
+	// 同Days2HMS(fd * 24.0, hh, mm, ss)
+	fd *= 24.0;
+	hh = (int) fd;
+	fd = (fd - hh) * 60.0;
+	mm = (int) fd;
+	ss = (fd - mm) * 60.0;
+
+	char *p = &buff_[0] + size_;
+	p = put_int(p, iy, 0, false);
+	*p++ = ' ';
+	p = put_int(p, im, 2, true);
+	*p++ = ' ';
+	p = put_int(p, id, 2, true);
+	*p++ = ' ';
+	p = put_int(p, hh, 2, true);
+	*p++ = ' ';
+	p = put_int(p, mm, 2, true);
+	*p++ = ' ';
+	p = put_fixed(p, ss, 6, 3, true);
+	*p++ = ' ';
+	p = put_int(p, pt.fno, 4, false);
+	*p++ = ' ';
+	p = put_fixed(p, pt.ra, 9, 5, false);
+	*p++ = ' ';
+	p = put_fixed(p, pt.dc, 9, 5, false);
+	*p++ = ' ';
+	if (pt.mag > 20.0) {
+		memcpy(p, "99.99", 5);
+		p += 5;
+	}
+	else p = put_fixed(p, pt.mag, 5, 2, false);
+	*p++ = '\r';
+	*p++ = '\n';
+	size_ = p - &buff_[0];
+}
+
+void APVFormat::Date(double mjd, int &iy, int &im, int &id, double &fd) {
+	int jdn = int(mjd + MJD0 + 0.5);
+	if (jdn != jdn_) {
+		ATimeSpace::Mjd2Cal(mjd, iy_, im_, id_, fd);
+		jdn_ = jdn;
+	}
+	iy = iy_;
+	im = im_;
+	id = id_;
+	fd = fmod(mjd, 1.0);
+}
+
+char *APVFormat::put_int(char *p, int val, int width, bool zero) {
+	char digits[12];
+	int n(0), len;
+	bool neg = val < 0;
+	unsigned int v = neg ? 0U - (unsigned int) val : (unsigned int) val;
+
+	do {
+		digits[n++] = char('0' + v % 10);
+		v /= 10;
+	} while (v);
+	len = n + neg;
+	if (!zero) for (; len < width; ++len) *p++ = ' ';
+	if (neg) *p++ = '-';
+	if (zero) for (; len < width; ++len) *p++ = '0';
+	while (n) *p++ = digits[--n];
+	return p;
+}
+
+char *APVFormat::put_fixed(char *p, double val, int width, int prec, bool zero) {
+	char text[400];	// 双精度实数定点表示的最大长度: 309位整数+符号+小数
+	char *s = text;
+	int len;
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+	len = std::to_chars(text, text + sizeof(text), val, std::chars_format::fixed, prec).ptr - text;
+#else
+	len = snprintf(text, sizeof(text), "%.*f", prec, val);
+#endif
+	if (len >= width) {
+		memcpy(p, text, len);
+		return p + len;
+	}
+	if (!zero || !isfinite(val)) {// printf()对inf/nan不填充'0'
+		memset(p, ' ', width - len);
+		memcpy(p + width - len, text, len);
+		return p + width;
+	}
+	if (*s == '-') {
+		*p++ = *s++;
+		--len;
+		--width;
+	}
+	memset(p, '0', width - len);
+	memcpy(p + width - len, s, len);
+	return p + width;
+}
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,94 @@
+/*
+ * @file APVFormat.h 类APVFormat的声明文件
+ * APVFormat -- 生成识别目标的输出文本. 逐行写入可复用的缓冲区
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * 输出行格式与原fprintf()输出逐字节一致:
+ * "%d %02d %02d %02d %02d %06.3f %4d %9.5f %9.5f " + "99.99\r\n"(mag > 20) 或 "%5.2f\r\n"
+ *
+ * @note
+ * - 整数使用定宽格式化函数; 实数使用std::to_chars(), 其舍入规则与printf()相同.
+ *   不支持浮点std::to_chars()的标准库中退回snprintf()
+ * - 相邻数据点位于同一日时, 复用日期换算结果
+ */
+
+#ifndef APVFORMAT_H_
+#define APVFORMAT_H_
+
+#include <stddef.h>
+#include <vector>
+#include "APVRec.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+class APVFormat {
+public:
+	APVFormat();
+	virtual ~APVFormat();
+
+protected:
+	enum {
+		ROW_MAX = 2048	//< 单行最大字节数: 含3个任意量级的实数
+	};
+
+	std::vector<char> buff_;	//< 输出缓冲区
+	size_t size_;	//< 已写入字节数
+	int jdn_;		//< 缓存日期对应的儒略日数
+	int iy_, im_, id_;	//< 缓存日期
+
+public:
+	/*!
+	 * @brief 清空缓冲区. 保留已分配的内存
+	 */
+	void Clear() {
+		size_ = 0;
+	}
+	/*!
+	 * @brief 缓冲区内容
+	 */
+	const char *Data() const {
+		return size_ ? &buff_[0] : "";
+	}
+	/*!
+	 * @brief 缓冲区字节数
+	 */
+	size_t Size() const {
+		return size_;
+	}
+	/*!
+	 * @brief 追加一个目标的所有数据点
+	 */
+	void Object(const PVOBJ &obj);
+	/*!
+	 * @brief 追加一个数据点
+	 */
+	void Row(const PVPT &pt);
+	/*!
+	 * @brief 由修正儒略日计算日期, 同一日的结果被缓存
+	 * @note
+	 * 结果与ATimeSpace::Mjd2Cal()一致
+	 */
+	void Date(double mjd, int &iy, int &im, int &id, double &fd);
+
+protected:
+	/*!
+	 * @brief 格式化整数, 等效于"%*d"或"%0*d"
+	 * @param p     输出地址
+	 * @param val   整数
+	 * @param width 最小宽度
+	 * @param zero  是否以'0'填充
+	 * @return
+	 * 输出结束地址
+	 */
+	static char *put_int(char *p, int val, int width, bool zero);
+	/*!
+	 * @brief 格式化实数, 等效于"%*.*f"或"%0*.*f"
+	 */
+	static char *put_fixed(char *p, double val, int width, int prec, bool zero);
+};
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif /* APVFORMAT_H_ */
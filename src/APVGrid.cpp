@@ -0,0 +1,118 @@
+/*
+ * @file APVGrid.cpp 类APVGrid的定义文件
+ * @version 0.1
+ * @date Oct 17, 2026
+ */
+#include <math.h>
+#include "APVGrid.h"
+#include "APVKernel.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+APVGrid::APVGrid() {
+	cell_ = 1.0;
+	x0_ = y0_ = 0.0;
+	nx_ = ny_ = 0;
+}
+
+APVGrid::~APVGrid() {
+}
+
+void APVGrid::Build(int n, const double *x, const double *y, double cell) {
+	Reset();
+	if (n <= 0) return;
+
+	double xmin(0.0), xmax(0.0), ymin(0.0), ymax(0.0);
+	int i, k, ncell, nvalid(0);
+
+	for (i = 0; i < n; ++i) {// 坐标非有限值的数据点不参与索引
+		if (!(isfinite(x[i]) && isfinite(y[i]))) continue;
+		if (!nvalid++) {
+			xmin = xmax = x[i];
+			ymin = ymax = y[i];
+			continue;
+		}
+		if (x[i] < xmin) xmin = x[i];
+		else if (x[i] > xmax) xmax = x[i];
+		if (y[i] < ymin) ymin = y[i];
+		else if (y[i] > ymax) ymax = y[i];
+	}
+	if (!nvalid) return;
+	/*
+	 * 网格数量不超过数据点数量的4倍:
+	 * 网格过细时, 空网格的遍历开销将超过比对开销
+	 */
+	if (!(cell > 0.0 && isfinite(cell))) cell = 1.0;
+	while (((xmax - xmin) / cell + 1.0) * ((ymax - ymin) / cell + 1.0) > 4.0 * nvalid + 16.0)
+		cell *= 2.0;
+	cell_ = cell;
+	x0_   = xmin;
+	y0_   = ymin;
+	nx_   = int((xmax - xmin) / cell) + 1;
+	ny_   = int((ymax - ymin) / cell) + 1;
+	ncell = nx_ * ny_;
+
+	// 计数排序: 保持网格内数据点的原始次序
+	start_.assign(ncell + 1, 0);
+	ids_.resize(nvalid);
+	std::vector<int> cid(n);
+	for (i = 0; i < n; ++i) {
+		if (!(isfinite(x[i]) && isfinite(y[i]))) cid[i] = -1;
+		else {
+			cid[i] = cell_index(y[i], y0_, ny_) * nx_ + cell_index(x[i], x0_, nx_);
+			++start_[cid[i] + 1];
+		}
+	}
+	for (k = 0; k < ncell; ++k) start_[k + 1] += start_[k];
+	std::vector<int> pos(start_.begin(), start_.end() - 1);
+	xs_.resize(nvalid);
+	ys_.resize(nvalid);
+	for (i = 0; i < n; ++i) {
+		if (cid[i] < 0) continue;
+		k = pos[cid[i]]++;
+		ids_[k] = i;
+		xs_[k]  = x[i];
+		ys_[k]  = y[i];
+	}
+}
+
+void APVGrid::Reset() {
+	nx_ = ny_ = 0;
+	start_.clear();
+	ids_.clear();
+	xs_.clear();
+	ys_.clear();
+}
+
+int APVGrid::Match(double x, double y, double lo, double hi, std::vector<int> &ids) const {
+	if (!nx_ || !(isfinite(x) && isfinite(y) && isfinite(hi))
+			|| x + hi < x0_ || x - hi > x0_ + nx_ * cell_
+			|| y + hi < y0_ || y - hi > y0_ + ny_ * cell_)
+		return 0;
+
+	int ix0 = cell_index(x - hi, x0_, nx_);
+	int ix1 = cell_index(x + hi, x0_, nx_);
+	int iy0 = cell_index(y - hi, y0_, ny_);
+	int iy1 = cell_index(y + hi, y0_, ny_);
+	int row, i0, i1, m(0);
+
+	for (int iy = iy0; iy <= iy1; ++iy) {
+		// 同一行中相邻网格的数据点连续存储
+		row = iy * nx_;
+		i0  = start_[row + ix0];
+		i1  = start_[row + ix1 + 1];
+		if (i0 == i1) continue;
+		if (int(pos_.size()) < m + i1 - i0) pos_.resize(m + i1 - i0);
+		m += pv_window_match(x, y, &xs_[i0], &ys_[i0], i1 - i0, lo, hi, &pos_[m], i0);
+	}
+	for (int i = 0; i < m; ++i) ids.push_back(ids_[pos_[i]]);
+	return m;
+}
+
+int APVGrid::cell_index(double v, double v0, int nv) const {
+	// 先在浮点域限定范围, 再转换为整数, 避免超出int范围
+	double i = floor((v - v0) / cell_);
+	return i < 0.0 ? 0 : (i >= nv ? nv - 1 : int(i));
+}
+///////////////////////////////////////////////////////////////////////////////
+}
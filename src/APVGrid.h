@@ -0,0 +1,77 @@
+/*
+ * @file APVGrid.h 类APVGrid的声明文件
+ * APVGrid -- 平面点集的均匀网格索引
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * 使用流程:
+ * (1) Build(), 由一帧数据的XY坐标建立索引
+ * (2) Match(), 查找与参考点XY偏差位于阈值区间内的数据点
+ *
+ * @note
+ * - 网格按行存储, 同一网格内数据点按原始序号递增排列
+ * - 数据点坐标按网格次序复制存储, 同一行相邻网格的坐标连续, 由APVKernel逐行比对
+ * - 坐标为非有限值(inf/nan)的数据点不参与索引, 参考点坐标为非有限值时无匹配结果
+ */
+
+#ifndef APVGRID_H_
+#define APVGRID_H_
+
+#include <vector>
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+class APVGrid {
+public:
+	APVGrid();
+	virtual ~APVGrid();
+
+protected:
+	double cell_;		//< 网格边长, 量纲: 像素
+	double x0_, y0_;	//< 网格原点
+	int nx_, ny_;		//< 网格数量
+	std::vector<int> start_;	//< 各网格在ids_中的起始位置
+	std::vector<int> ids_;		//< 按网格排列的数据点序号
+	std::vector<double> xs_, ys_;	//< 按网格排列的数据点坐标
+	mutable std::vector<int> pos_;	//< 比对结果缓存: 在ids_中的位置
+
+public:
+	/*!
+	 * @brief 建立索引
+	 * @param n    数据点数量
+	 * @param x    X坐标
+	 * @param y    Y坐标
+	 * @param cell 网格边长. 通常取查找半径
+	 * @note
+	 * 坐标为非有限值的数据点被跳过, 不会出现在Match()的输出中
+	 */
+	void Build(int n, const double *x, const double *y, double cell);
+	/*!
+	 * @brief 清除索引
+	 */
+	void Reset();
+	/*!
+	 * @brief 查找与参考点XY偏差位于[lo, hi]内的数据点
+	 * @param x   参考点X坐标
+	 * @param y   参考点Y坐标
+	 * @param lo  XY偏差下限
+	 * @param hi  XY偏差上限
+	 * @param ids 数据点序号. 追加方式输出, 未排序
+	 * @return
+	 * 输出的数据点数量. 参考点坐标为非有限值时返回0
+	 * @note
+	 * 判据: lo <= |dx| <= hi 且 lo <= |dy| <= hi
+	 */
+	int Match(double x, double y, double lo, double hi, std::vector<int> &ids) const;
+
+protected:
+	/*!
+	 * @brief 计算坐标对应的网格序号, 越界时限定在网格范围内
+	 */
+	int cell_index(double v, double v0, int nv) const;
+};
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif /* APVGRID_H_ */
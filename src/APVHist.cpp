@@ -0,0 +1,71 @@
+/*
+ * @file APVHist.cpp 类APVHist的定义文件
+ * @version 0.1
+ * @date Oct 17, 2026
+ */
+#include <math.h>
+#include <algorithm>
+#include "APVHist.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+APVHist::APVHist() : counts_(NBUCKET) {
+	Reset();
+}
+
+APVHist::~APVHist() {
+}
+
+void APVHist::Reset() {
+	std::fill(counts_.begin(), counts_.end(), 0);
+	total_ = 0;
+	min_   = UINT64_MAX;
+	max_   = 0;
+	sum_   = 0.0;
+}
+
+void APVHist::Record(uint64_t val) {
+	++counts_[bucket_index(val)];
+	++total_;
+	if (val < min_) min_ = val;
+	if (val > max_) max_ = val;
+	sum_ += val;
+}
+
+APVHist &APVHist::operator+=(const APVHist &other) {
+	for (int i = 0; i < NBUCKET; ++i) counts_[i] += other.counts_[i];
+	total_ += other.total_;
+	if (other.min_ < min_) min_ = other.min_;
+	if (other.max_ > max_) max_ = other.max_;
+	sum_ += other.sum_;
+	return *this;
+}
+
+uint64_t APVHist::Percentile(double pct) const {
+	if (!total_) return 0;
+	uint64_t rank = uint64_t(ceil(pct * 0.01 * total_)), sum(0);
+	if (rank < 1) rank = 1;
+	for (int i = 0; i < NBUCKET; ++i) {
+		if ((sum += counts_[i]) >= rank) {
+			uint64_t val = bucket_upper(i);
+			return val < max_ ? val : max_;
+		}
+	}
+	return max_;
+}
+
+int APVHist::bucket_index(uint64_t val) {
+	if (val < LINEAR) return int(val);
+	int mag = 63 - __builtin_clzll(val);	// 2^mag <= val < 2^(mag+1)
+	if (mag >= MAGMAX) return NBUCKET - 1;
+	int shift = mag - 5;	// (val >> shift)位于[SUB, 2 * SUB)
+	return LINEAR + (mag - 6) * SUB + int(val >> shift) - SUB;
+}
+
+uint64_t APVHist::bucket_upper(int idx) {
+	if (idx < LINEAR) return idx;
+	int j = idx - LINEAR, shift = j / SUB + 1;
+	return ((uint64_t(j % SUB + SUB) + 1) << shift) - 1;
+}
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,95 @@
+/*
+ * @file APVHist.h 类APVHist的声明文件
+ * APVHist -- 对数-线性分桶的延迟直方图(HDR风格), 用于统计单帧处理时间
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * - 数值量纲: 微秒. [0, 64)逐一计数; 此后每个2的幂区间均分为32个桶, 相对误差不大于1/32
+ * - 可记录的最大值为2^40微秒(约12天), 更大的数值计入最后一个桶
+ * - 百分位数返回对应桶的上界, 并以实际最大值为限
+ */
+
+#ifndef APVHIST_H_
+#define APVHIST_H_
+
+#include <stdint.h>
+#include <vector>
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+class APVHist {
+public:
+	APVHist();
+	virtual ~APVHist();
+
+protected:
+	enum {
+		LINEAR = 64,	//< 逐一计数的区间
+		SUB    = 32,	//< 每个2的幂区间的桶数
+		MAGMAX = 40,	//< 最大数量级
+		NBUCKET = LINEAR + (MAGMAX - 6) * SUB	//< 桶数
+	};
+
+	std::vector<uint64_t> counts_;	//< 各桶计数
+	uint64_t total_;	//< 总计数
+	uint64_t min_, max_;	//< 最小值与最大值
+	double sum_;		//< 累加值
+
+public:
+	/*!
+	 * @brief 清空计数
+	 */
+	void Reset();
+	/*!
+	 * @brief 记录一个数值
+	 */
+	void Record(uint64_t val);
+	/*!
+	 * @brief 合并另一个直方图
+	 */
+	APVHist &operator+=(const APVHist &other);
+	/*!
+	 * @brief 总计数
+	 */
+	uint64_t Count() const {
+		return total_;
+	}
+	/*!
+	 * @brief 最小值. 无计数时为0
+	 */
+	uint64_t Min() const {
+		return total_ ? min_ : 0;
+	}
+	/*!
+	 * @brief 最大值
+	 */
+	uint64_t Max() const {
+		return max_;
+	}
+	/*!
+	 * @brief 平均值
+	 */
+	double Mean() const {
+		return total_ ? sum_ / total_ : 0.0;
+	}
+	/*!
+	 * @brief 百分位数
+	 * @param pct 百分比, 范围: [0, 100]
+	 */
+	uint64_t Percentile(double pct) const;
+
+protected:
+	/*!
+	 * @brief 数值对应的桶序号
+	 */
+	static int bucket_index(uint64_t val);
+	/*!
+	 * @brief 桶内可表示的最大值
+	 */
+	static uint64_t bucket_upper(int idx);
+};
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif /* APVHIST_H_ */
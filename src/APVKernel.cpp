@@ -0,0 +1,111 @@
+/*
+ * @file APVKernel.cpp 位置偏差窗口比对核函数
+ * @version 0.1
+ * @date Oct 17, 2026
+ */
+#include <math.h>
+#include "APVKernel.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define PV_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+typedef int (*match_func)(double, double, const double*, const double*, int,
+		double, double, int*, int);
+
+static int match_scalar(double x0, double y0, const double *x, const double *y, int n,
+		double lo, double hi, int *ids, int base) {
+	double dx, dy;
+	int m(0);
+
+	for (int i = 0; i < n; ++i) {
+		dx = fabs(x[i] - x0);
+		dy = fabs(y[i] - y0);
+		if (lo <= dx && dx <= hi && lo <= dy && dy <= hi) ids[m++] = base + i;
+	}
+	return m;
+}
+
+#ifdef PV_KERNEL_X86
+__attribute__((target("sse2")))
+static int match_sse2(double x0, double y0, const double *x, const double *y, int n,
+		double lo, double hi, int *ids, int base) {
+	const __m128d sign = _mm_set1_pd(-0.0);
+	const __m128d vx0 = _mm_set1_pd(x0), vy0 = _mm_set1_pd(y0);
+	const __m128d vlo = _mm_set1_pd(lo), vhi = _mm_set1_pd(hi);
+	__m128d dx, dy, ok;
+	int i(0), m(0), mask;
+
+	for (; i + 2 <= n; i += 2) {
+		dx = _mm_andnot_pd(sign, _mm_sub_pd(_mm_loadu_pd(x + i), vx0));
+		dy = _mm_andnot_pd(sign, _mm_sub_pd(_mm_loadu_pd(y + i), vy0));
+		ok = _mm_and_pd(_mm_and_pd(_mm_cmpge_pd(dx, vlo), _mm_cmple_pd(dx, vhi)),
+				_mm_and_pd(_mm_cmpge_pd(dy, vlo), _mm_cmple_pd(dy, vhi)));
+		for (mask = _mm_movemask_pd(ok); mask; mask &= mask - 1)
+			ids[m++] = base + i + __builtin_ctz(mask);
+	}
+	return m + match_scalar(x0, y0, x + i, y + i, n - i, lo, hi, ids + m, base + i);
+}
+
+__attribute__((target("avx2")))
+static int match_avx2(double x0, double y0, const double *x, const double *y, int n,
+		double lo, double hi, int *ids, int base) {
+	const __m256d sign = _mm256_set1_pd(-0.0);
+	const __m256d vx0 = _mm256_set1_pd(x0), vy0 = _mm256_set1_pd(y0);
+	const __m256d vlo = _mm256_set1_pd(lo), vhi = _mm256_set1_pd(hi);
+	__m256d dx, dy, ok;
+	int i(0), m(0), mask;
+
+	for (; i + 4 <= n; i += 4) {
+		dx = _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_loadu_pd(x + i), vx0));
+		dy = _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_loadu_pd(y + i), vy0));
+		ok = _mm256_and_pd(
+				_mm256_and_pd(_mm256_cmp_pd(dx, vlo, _CMP_GE_OQ), _mm256_cmp_pd(dx, vhi, _CMP_LE_OQ)),
+				_mm256_and_pd(_mm256_cmp_pd(dy, vlo, _CMP_GE_OQ), _mm256_cmp_pd(dy, vhi, _CMP_LE_OQ)));
+		for (mask = _mm256_movemask_pd(ok); mask; mask &= mask - 1)
+			ids[m++] = base + i + __builtin_ctz(mask);
+	}
+	return m + match_scalar(x0, y0, x + i, y + i, n - i, lo, hi, ids + m, base + i);
+}
+#endif
+
+static match_func select_kernel(const char *&name) {
+#ifdef PV_KERNEL_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		name = "avx2";
+		return match_avx2;
+	}
+	if (__builtin_cpu_supports("sse2")) {
+		name = "sse2";
+		return match_sse2;
+	}
+#endif
+	name = "scalar";
+	return match_scalar;
+}
+
+static const char *kernel_name;
+static match_func kernel = select_kernel(kernel_name);
+
+int pv_window_match(double x0, double y0, const double *x, const double *y, int n,
+		double lo, double hi, int *ids, int base) {
+	return (*kernel)(x0, y0, x, y, n, lo, hi, ids, base);
+}
+
+const char *pv_kernel_name() {
+	return kernel_name;
+}
+
+void pv_kernel_scalar(bool scalar) {
+	if (scalar) {
+		kernel = match_scalar;
+		kernel_name = "scalar";
+	}
+	else kernel = select_kernel(kernel_name);
+}
+///////////////////////////////////////////////////////////////////////////////
+}
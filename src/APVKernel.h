@@ -0,0 +1,48 @@
+/*
+ * @file APVKernel.h 位置偏差窗口比对核函数
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * - 比对一个参考点与一组连续存储的XY坐标, 输出XY偏差均位于[lo, hi]内的数据点序号
+ * - 运行时依据CPU特性选择AVX2、SSE2或标量实现, 三者输出一致
+ * - create_candidates()中lo/hi对应stepmin/stepmax; append_candidates()中对应0/dxymax
+ */
+
+#ifndef APVKERNEL_H_
+#define APVKERNEL_H_
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+/*!
+ * @brief 比对参考点与连续存储的XY坐标
+ * @param x0   参考点X坐标
+ * @param y0   参考点Y坐标
+ * @param x    X坐标数组
+ * @param y    Y坐标数组
+ * @param n    数组长度
+ * @param lo   XY偏差下限
+ * @param hi   XY偏差上限
+ * @param ids  输出序号, 容量不小于n
+ * @param base 输出序号的偏移量: ids = base + 数组下标
+ * @return
+ * 符合判据的数据点数量
+ * @note
+ * 判据: lo <= |x - x0| <= hi 且 lo <= |y - y0| <= hi
+ */
+int pv_window_match(double x0, double y0, const double *x, const double *y, int n,
+		double lo, double hi, int *ids, int base = 0);
+/*!
+ * @brief 查看运行时选择的核函数实现
+ * @return
+ * "avx2", "sse2"或"scalar"
+ */
+const char *pv_kernel_name();
+/*!
+ * @brief 强制使用标量实现. 用于对比测试
+ */
+void pv_kernel_scalar(bool scalar);
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif /* APVKERNEL_H_ */
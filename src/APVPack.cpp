@@ -0,0 +1,153 @@
+/*
+ * @file APVPack.cpp 类APVPack的定义文件
+ * @version 0.1
+ * @date Oct 17, 2026
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <boost/filesystem.hpp>
+#include <boost/static_assert.hpp>
+#include "APVPack.h"
+#include "APVReader.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+BOOST_STATIC_ASSERT(sizeof(PVPACKIDX) == 56);
+
+APVPack::APVPack() {
+	fddat_  = -1;
+	fdidx_  = -1;
+	offset_ = 0;
+	error_  = false;
+}
+
+APVPack::~APVPack() {
+	Close();
+}
+
+bool APVPack::Open(const char *dirDst) {
+	namespace fs = boost::filesystem;
+	fs::path path;
+	struct stat st;
+
+	Close();
+	path = dirDst;
+	path /= PVPACK_DATA;
+	if ((fddat_ = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644)) < 0) return false;
+	path = dirDst;
+	path /= PVPACK_INDEX;
+	if ((fdidx_ = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644)) < 0) {
+		close(fddat_);
+		fddat_ = -1;
+		return false;
+	}
+	offset_ = fstat(fddat_, &st) == 0 ? st.st_size : 0;
+	bufdat_.reserve(BUFF_SIZE);
+	error_ = false;
+	return true;
+}
+
+bool APVPack::Close() {
+	bool rslt;
+
+	if (fddat_ < 0) return true;
+	Flush();
+	if (fsync(fddat_) || fsync(fdidx_)) error_ = true;
+	if (close(fddat_)) error_ = true;
+	if (close(fdidx_)) error_ = true;
+	fddat_ = fdidx_ = -1;
+	rslt = !error_;
+	std::vector<char>().swap(bufdat_);
+	std::vector<PVPACKIDX>().swap(bufidx_);
+	return rslt;
+}
+
+void APVPack::Append(const char *name, const char *data, size_t len) {
+	PVPACKIDX idx;
+
+	memset(&idx, 0, sizeof(idx));
+	strncpy(idx.name, name, sizeof(idx.name) - 1);
+	idx.offset = offset_ + bufdat_.size();
+	idx.length = len;
+	if (bufdat_.size() + len > BUFF_SIZE) Flush();
+	if (len > BUFF_SIZE) {// 超大目标直接写入
+		if (!write_all(fddat_, data, len)) error_ = true;
+		offset_ += len;
+	}
+	else bufdat_.insert(bufdat_.end(), data, data + len);
+	bufidx_.push_back(idx);
+}
+
+void APVPack::Flush() {
+	if (fddat_ < 0) return;
+	// 先写数据后写索引: 中断时索引不会指向不存在的数据
+	if (bufdat_.size()) {
+		if (!write_all(fddat_, &bufdat_[0], bufdat_.size())) error_ = true;
+		offset_ += bufdat_.size();
+		bufdat_.clear();
+	}
+	if (bufidx_.size()) {
+		if (!write_all(fdidx_, &bufidx_[0], bufidx_.size() * sizeof(PVPACKIDX))) error_ = true;
+		bufidx_.clear();
+	}
+}
+
+bool APVPack::write_all(int fd, const void *data, size_t len) {
+	const char *p = (const char*) data;
+	ssize_t n;
+
+	while (len) {
+		if ((n = write(fd, p, len)) < 0) {
+			if (errno == EINTR) continue;
+			return false;
+		}
+		p   += n;
+		len -= n;
+	}
+	return true;
+}
+
+int APVPack::Explode(const char *dirPack, const char *dirDst) {
+	namespace fs = boost::filesystem;
+	fs::path path;
+	APVReader reader;
+	PVPACKIDX idx;
+	FILE *fpidx, *fpdst;
+	int n(0);
+
+	path = dirPack;
+	path /= PVPACK_DATA;
+	if (!reader.Open(path.c_str())) return -1;
+	path = dirPack;
+	path /= PVPACK_INDEX;
+	if (!(fpidx = fopen(path.c_str(), "rb"))) return -2;
+	boost::system::error_code ec;
+	fs::create_directories(dirDst, ec);
+
+	const char *data = reader.Data();
+	uint64_t size = reader.Size();
+	while (fread(&idx, sizeof(idx), 1, fpidx) == 1) {
+		idx.name[sizeof(idx.name) - 1] = 0;
+		if (idx.offset > size || idx.length > size - idx.offset || !idx.name[0] || strchr(idx.name, '/')) {
+			n = -3;	// 索引与数据不一致
+			break;
+		}
+		path = dirDst;
+		path /= idx.name;
+		if (!(fpdst = fopen(path.c_str(), "wb"))) {
+			n = -4;
+			break;
+		}
+		if (idx.length) fwrite(data + idx.offset, 1, idx.length, fpdst);
+		fclose(fpdst);
+		++n;
+	}
+	fclose(fpidx);
+	return n;
+}
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,99 @@
+/*
+ * @file APVPack.h 类APVPack的声明文件
+ * APVPack -- 合并输出识别目标. 所有目标写入同一个数据文件, 以索引文件定位
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * 目录中包含两个文件, 均以追加方式写入:
+ * - objects.dat: 各目标文件内容依次拼接, 内容与逐目标输出的文件相同
+ * - objects.idx: PVPACKIDX数组, 每个目标一项, 小端字节序
+ *
+ * @note
+ * - 写入时使用大块缓冲区, 缓冲区满或Close()时写入磁盘
+ * - Explode()按索引次序还原逐目标文件. 同名目标以后写入者为准, 与逐目标输出一致
+ */
+
+#ifndef APVPACK_H_
+#define APVPACK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+#define PVPACK_DATA		"objects.dat"	//< 数据文件名
+#define PVPACK_INDEX	"objects.idx"	//< 索引文件名
+
+typedef struct pv_packidx {// 目标索引
+	char name[40];		//< 逐目标输出时的文件名, 以'\0'结尾
+	uint64_t offset;	//< 在数据文件中的偏移量
+	uint64_t length;	//< 字节数
+}PVPACKIDX;
+
+class APVPack {
+public:
+	APVPack();
+	virtual ~APVPack();
+
+protected:
+	enum {
+		BUFF_SIZE = 1 << 22	//< 写缓冲区字节数
+	};
+
+	int fddat_;		//< 数据文件描述符
+	int fdidx_;		//< 索引文件描述符
+	uint64_t offset_;	//< 数据文件当前长度
+	std::vector<char> bufdat_;	//< 数据文件写缓冲区
+	std::vector<PVPACKIDX> bufidx_;	//< 索引文件写缓冲区
+	bool error_;	//< 写入出错
+
+public:
+	/*!
+	 * @brief 在目录中打开或创建数据文件与索引文件
+	 */
+	bool Open(const char *dirDst);
+	/*!
+	 * @brief 将缓冲区写入文件, 同步至磁盘并关闭文件
+	 * @return
+	 * 所有写入是否成功
+	 */
+	bool Close();
+	/*!
+	 * @brief 是否已打开
+	 */
+	bool IsOpen() const {
+		return fddat_ >= 0;
+	}
+	/*!
+	 * @brief 追加一个目标
+	 * @param name 逐目标输出时的文件名
+	 * @param data 文件内容
+	 * @param len  字节数
+	 */
+	void Append(const char *name, const char *data, size_t len);
+	/*!
+	 * @brief 将缓冲区写入磁盘
+	 */
+	void Flush();
+	/*!
+	 * @brief 将合并输出还原为逐目标文件
+	 * @param dirPack 合并输出所在目录
+	 * @param dirDst  逐目标文件目录
+	 * @return
+	 * 还原的目标数量. 失败时为负数
+	 */
+	static int Explode(const char *dirPack, const char *dirDst);
+
+protected:
+	/*!
+	 * @brief 完整写入一段数据
+	 */
+	bool write_all(int fd, const void *data, size_t len);
+};
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif /* APVPACK_H_ */
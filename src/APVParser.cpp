@@ -0,0 +1,170 @@
+/*
+ * @file APVParser.cpp 类APVParser的定义文件
+ * @version 0.1
+ * @date Oct 17, 2026
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "APVParser.h"
+#include "ATimeSpace.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+#define FAST_DIGITS		15	//< 直接计算实数时的最大有效数字位数
+
+APVParser::APVParser() {
+	iy_ = im_ = id_ = 0;
+	second_ = -1;
+	mics_   = -1;
+	mjd0_   = 0.0;
+	mjd_    = 0.0;
+}
+
+APVParser::~APVParser() {
+}
+
+int APVParser::Resolve(const char *line, const char *end, PVPT &pt, int &camid) {
+	int iy, im, id, hh, mm, ss, mics;
+	double errmag;
+	const char *p = skip_space(line, end);
+
+	if (p == end || *p == '#') return PARSE_BLANK;
+	// UTC: YYYY-MM-DD hh:mm:ss
+	if (!(p = parse_int(p, end, iy)) || p == end || *p++ != '-'
+			|| !(p = parse_int(p, end, im)) || p == end || *p++ != '-'
+			|| !(p = parse_int(p, end, id))
+			|| !(p = parse_int(p, end, hh)) || p == end || *p++ != ':'
+			|| !(p = parse_int(p, end, mm)) || p == end || *p++ != ':'
+			|| !(p = parse_int(p, end, ss)))
+		return PARSE_UTC;
+	if (im < 1 || im > 12 || id < 1 || id > 31
+			|| hh < 0 || hh > 23 || mm < 0 || mm > 59 || ss < 0 || ss > 60)
+		return PARSE_UTC;
+	// 其它字段以','分隔
+	if (!(p = skip_comma(p, end)) || !(p = parse_int(p, end, pt.fno))) return PARSE_FNO;
+	if (!(p = skip_comma(p, end)) || !(p = parse_double(p, end, pt.x)))  return PARSE_X;
+	if (!(p = skip_comma(p, end)) || !(p = parse_double(p, end, pt.y)))  return PARSE_Y;
+	if (!(p = skip_comma(p, end)) || !(p = parse_double(p, end, pt.ra))) return PARSE_RA;
+	if (!(p = skip_comma(p, end)) || !(p = parse_double(p, end, pt.dc))) return PARSE_DEC;
+	if (!(p = skip_comma(p, end)) || !(p = parse_double(p, end, pt.mag))) return PARSE_MAG;
+	if (!(p = skip_comma(p, end)) || !(p = parse_double(p, end, errmag))) return PARSE_MAGERR;
+	if (!(p = skip_comma(p, end)) || !(p = parse_int(p, end, mics))) return PARSE_MICS;
+	if (!(p = skip_comma(p, end)) || !(p = parse_int(p, end, camid))) return PARSE_CAMID;
+	if (skip_space(p, end) != end) return PARSE_TAIL;
+
+	pt.related = 0;
+	pt.mjd = modified_julian_day(iy, im, id, hh, mm, ss, mics);
+	return PARSE_OK;
+}
+
+int APVParser::Resolve(const char *line, PVPT &pt, int &camid) {
+	return Resolve(line, line + strlen(line), pt, camid);
+}
+
+/*
+ * ModifiedJulianDay(iy, im, id, fd)的结果为整数日与fd之和,
+ * 因此缓存整数日后再加fd, 与直接调用逐位一致
+ */
+double APVParser::modified_julian_day(int iy, int im, int id, int hh, int mm, int ss, int mics) {
+	int second = (hh * 60 + mm) * 60 + ss;
+
+	if (id != id_ || im != im_ || iy != iy_) {
+		iy_     = iy;
+		im_     = im;
+		id_     = id;
+		mjd0_   = ATimeSpace::ModifiedJulianDay(iy, im, id, 0.0);
+		second_ = -1;
+	}
+	if (second != second_ || mics != mics_) {
+		second_ = second;
+		mics_   = mics;
+		mjd_    = mjd0_ + (hh + (mm + (ss + mics * 1E-6 + 5.0) / 60.0) / 60.0) / 24.0;
+	}
+	return mjd_;
+}
+
+const char *APVParser::ErrorString(int code) {
+	static const char *errstr[] = {
+		"success",
+		"invalid UTC",
+		"invalid frame number",
+		"invalid X",
+		"invalid Y",
+		"invalid ra",
+		"invalid dec",
+		"invalid mag",
+		"invalid mag_error",
+		"invalid microsecond",
+		"invalid camera id",
+		"unexpected trailing characters"
+	};
+
+	if (code == PARSE_BLANK) return "blank line";
+	if (code > 0 || code < PARSE_TAIL) return "unknown error";
+	return errstr[-code];
+}
+
+const char *APVParser::skip_space(const char *p, const char *end) {
+	while (p != end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) ++p;
+	return p;
+}
+
+const char *APVParser::skip_comma(const char *p, const char *end) {
+	p = skip_space(p, end);
+	return (p != end && *p == ',') ? p + 1 : NULL;
+}
+
+const char *APVParser::parse_int(const char *p, const char *end, int &val) {
+	bool neg(false);
+	long long v(0);
+	const char *p0;
+
+	p = skip_space(p, end);
+	if (p != end && (*p == '-' || *p == '+')) neg = *p++ == '-';
+	for (p0 = p; p != end && *p >= '0' && *p <= '9'; ++p) {
+		v = v * 10 + (*p - '0');
+		if (v > 0x7FFFFFFFLL) return NULL;
+	}
+	if (p == p0) return NULL;
+	val = int(neg ? -v : v);
+	return p;
+}
+
+const char *APVParser::parse_double(const char *p, const char *end, double &val) {
+	static const double pow10[] = {
+		1E0, 1E1, 1E2, 1E3, 1E4, 1E5, 1E6, 1E7, 1E8,
+		1E9, 1E10, 1E11, 1E12, 1E13, 1E14, 1E15
+	};
+	bool neg(false);
+	unsigned long long m(0);
+	int ndigit(0), nfrac(0);
+	const char *p0;
+
+	p0 = p = skip_space(p, end);
+	if (p != end && (*p == '-' || *p == '+')) neg = *p++ == '-';
+	for (; p != end && *p >= '0' && *p <= '9'; ++p, ++ndigit) m = m * 10 + (*p - '0');
+	if (p != end && *p == '.') {
+		for (++p; p != end && *p >= '0' && *p <= '9'; ++p, ++ndigit, ++nfrac) m = m * 10 + (*p - '0');
+	}
+
+	if (ndigit && ndigit <= FAST_DIGITS && (p == end || (*p != 'e' && *p != 'E'))) {
+		/*
+		 * m < 10^15 < 2^53, 10^nfrac均可精确表示为double,
+		 * 一次除法的舍入结果与strtod()一致
+		 */
+		val = nfrac ? double(m) / pow10[nfrac] : double(m);
+		if (neg) val = -val;
+		return p;
+	}
+
+	// 有效数字过多, 含指数或特殊值: 复制为以'\0'结尾的字符串后调用strtod()
+	char buff[64];
+	char *tail;
+	int n = end - p0 < int(sizeof(buff)) - 1 ? end - p0 : sizeof(buff) - 1;
+	memcpy(buff, p0, n);
+	buff[n] = 0;
+	val = strtod(buff, &tail);
+	return tail == buff ? NULL : p0 + (tail - buff);
+}
+///////////////////////////////////////////////////////////////////////////////
+}
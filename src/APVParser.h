@@ -0,0 +1,110 @@
+/*
+ * @file APVParser.h 类APVParser的声明文件
+ * APVParser -- 原始数据行解析. 手写字段解析, 不分配内存
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * 文件行格式为:
+ * - 第一行: 注释, 解释每一列的涵义
+ * - 第二行至结束, 各列依次为:
+ * UTC(精度到秒), 帧编号, X, Y, ra, dec, mag, mag_error, 亚秒(微秒), 天区编号
+ * 例如:
+ * 2019-02-17 23:50:00, 1, 2878.429, 357.679, 28.78429, -1.42321, 15.406, 0.050, 123456, 3
+ *
+ * @note
+ * - 行数据不要求以'\0'结尾, 可直接解析内存映射文件中的行
+ * - 实数解析结果与strtod()逐位一致: 有效数字不超过15位且无指数时直接计算, 否则调用strtod()
+ * - 同一帧数据点的UTC相同: 缓存最近一次的日期与时刻, 仅在其变化时重新计算修正儒略日.
+ *   缓存结果与ATimeSpace::ModifiedJulianDay()逐位一致. 每个线程应使用独立的APVParser对象
+ */
+
+#ifndef APVPARSER_H_
+#define APVPARSER_H_
+
+#include "APVRec.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+class APVParser {
+public:
+	APVParser();
+	virtual ~APVParser();
+
+protected:
+	/* 时间转换缓存 */
+	int iy_, im_, id_;	//< 日期. 月为0表示无效
+	int second_;	//< 当日秒数
+	int mics_;		//< 微秒
+	double mjd0_;	//< 当日0时的修正儒略日
+	double mjd_;	//< 修正儒略日
+
+public:
+	enum {// 解析结果
+		PARSE_OK    = 0,	//< 解析成功
+		PARSE_BLANK = 1,	//< 空行, 应忽略
+		PARSE_UTC   = -1,	//< 字段格式错误: UTC
+		PARSE_FNO   = -2,	//< 字段格式错误: 帧编号
+		PARSE_X     = -3,	//< 字段格式错误: X
+		PARSE_Y     = -4,	//< 字段格式错误: Y
+		PARSE_RA    = -5,	//< 字段格式错误: ra
+		PARSE_DEC   = -6,	//< 字段格式错误: dec
+		PARSE_MAG   = -7,	//< 字段格式错误: mag
+		PARSE_MAGERR= -8,	//< 字段格式错误: mag_error
+		PARSE_MICS  = -9,	//< 字段格式错误: 亚秒
+		PARSE_CAMID = -10,	//< 字段格式错误: 天区编号
+		PARSE_TAIL  = -11	//< 行尾存在多余字符
+	};
+
+public:
+	/*!
+	 * @brief 解析一行原始数据
+	 * @param line  行起始地址
+	 * @param end   行结束地址, 可包含换行符
+	 * @param pt    数据点
+	 * @param camid 相机编号
+	 * @return
+	 * 解析结果, PARSE_OK/PARSE_BLANK/错误代码
+	 */
+	int Resolve(const char *line, const char *end, PVPT &pt, int &camid);
+	/*!
+	 * @brief 解析以'\0'结尾的一行原始数据
+	 */
+	int Resolve(const char *line, PVPT &pt, int &camid);
+	/*!
+	 * @brief 查看错误代码的说明
+	 */
+	static const char *ErrorString(int code);
+
+protected:
+	/*!
+	 * @brief 由UTC计算修正儒略日. 日期或时刻未变时使用缓存
+	 */
+	double modified_julian_day(int iy, int im, int id, int hh, int mm, int ss, int mics);
+	/*!
+	 * @brief 跳过空白字符
+	 */
+	static const char *skip_space(const char *p, const char *end);
+	/*!
+	 * @brief 跳过空白字符及字段分隔符','
+	 * @return
+	 * 分隔符后的地址. 无分隔符时为NULL
+	 */
+	static const char *skip_comma(const char *p, const char *end);
+	/*!
+	 * @brief 解析整数
+	 * @return
+	 * 整数后的地址. 格式错误时为NULL
+	 */
+	static const char *parse_int(const char *p, const char *end, int &val);
+	/*!
+	 * @brief 解析实数
+	 * @return
+	 * 实数后的地址. 格式错误时为NULL
+	 */
+	static const char *parse_double(const char *p, const char *end, double &val);
+};
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif /* APVPARSER_H_ */
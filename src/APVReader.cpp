@@ -0,0 +1,127 @@
+/*
+ * @file APVReader.cpp 类APVReader的定义文件
+ * @version 0.1
+ * @date Oct 17, 2026
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "APVReader.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+APVReader::APVReader() {
+	fd_     = -1;
+	owned_  = false;
+	map_    = NULL;
+	size_   = 0;
+	pos_    = 0;
+	head_   = tail_ = 0;
+	eof_    = false;
+	lineno_ = 0;
+}
+
+APVReader::~APVReader() {
+	Close();
+}
+
+bool APVReader::Open(const char *filepath) {
+	struct stat st;
+
+	Close();
+	if (strcmp(filepath, "-") == 0) fd_ = STDIN_FILENO;
+	else if ((fd_ = open(filepath, O_RDONLY)) < 0) return false;
+	else owned_ = true;
+
+	if (fstat(fd_, &st) == 0 && S_ISREG(st.st_mode)) {
+		if ((size_ = st.st_size) == 0) {// 空文件
+			eof_ = true;
+			return true;
+		}
+		void *addr = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+		if (addr != MAP_FAILED) {
+			map_ = (char*) addr;
+			madvise(map_, size_, MADV_SEQUENTIAL);
+			return true;
+		}
+		size_ = 0;
+	}
+	// 管道、FIFO或映射失败: 缓冲模式
+	buff_.resize(BLOCK_SIZE);
+	return true;
+}
+
+void APVReader::Close() {
+	if (map_) munmap(map_, size_);
+	if (owned_) close(fd_);
+	fd_    = -1;
+	owned_ = false;
+	map_   = NULL;
+	size_  = pos_ = 0;
+	head_  = tail_ = 0;
+	eof_   = false;
+	lineno_ = 0;
+	std::vector<char>().swap(buff_);
+}
+
+bool APVReader::NextLine(const char *&line, const char *&end) {
+	if (map_) {// 映射模式
+		if (pos_ >= size_) return false;
+		const char *p0 = map_ + pos_;
+		const char *p1 = (const char*) memchr(p0, '\n', size_ - pos_);
+		if (p1) pos_ = p1 - map_ + 1;
+		else {
+			p1 = map_ + size_;
+			pos_ = size_;
+		}
+		line = p0;
+		end  = p1;
+		++lineno_;
+		return true;
+	}
+
+	// 空的普通文件未分配缓冲区; 缓冲模式下数据已全部输出
+	if (fd_ < 0 || (eof_ && head_ == tail_)) return false;
+	size_t scanned(0);	// 已查找过的字节数, 相对head_
+	char *p1;
+	while (!(p1 = (char*) memchr(&buff_[0] + head_ + scanned, '\n', tail_ - head_ - scanned))) {
+		scanned = tail_ - head_;
+		if (!fill_buffer()) {// 文件尾: 最后一行可能无换行符
+			if (head_ == tail_) return false;
+			p1 = &buff_[0] + tail_;
+			break;
+		}
+	}
+	line  = &buff_[0] + head_;
+	end   = p1;
+	head_ = p1 - &buff_[0];
+	if (head_ < tail_) ++head_; // 跳过换行符
+	++lineno_;
+	return true;
+}
+
+bool APVReader::fill_buffer() {
+	if (eof_) return false;
+	if (head_) {// 未处理数据移至缓冲区头部
+		memmove(&buff_[0], &buff_[0] + head_, tail_ - head_);
+		tail_ -= head_;
+		head_ = 0;
+	}
+	if (buff_.size() - tail_ < BLOCK_SIZE / 2) buff_.resize(buff_.size() * 2); // 超长行
+
+	ssize_t n;
+	do {
+		n = read(fd_, &buff_[0] + tail_, buff_.size() - tail_);
+	} while (n < 0 && errno == EINTR);
+	if (n <= 0) {
+		eof_ = true;
+		return false;
+	}
+	tail_ += n;
+	return true;
+}
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,97 @@
+/*
+ * @file APVReader.h 类APVReader的声明文件
+ * APVReader -- 原始数据文件逐行读取
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * - 普通文件: mmap()映射整个文件, 并以MADV_SEQUENTIAL提示内核顺序访问. 行数据不复制
+ * - 管道、FIFO及标准输入("-"): 以大块缓冲区读取, 行长度不受限制
+ * - NextLine()输出的行不含换行符, 不以'\0'结尾. 缓冲模式下, 行数据在下次调用前有效
+ */
+
+#ifndef APVREADER_H_
+#define APVREADER_H_
+
+#include <stddef.h>
+#include <vector>
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+class APVReader {
+public:
+	APVReader();
+	virtual ~APVReader();
+
+protected:
+	enum {
+		BLOCK_SIZE = 1 << 20	//< 缓冲模式单次读取的字节数
+	};
+
+	int fd_;			//< 文件描述符
+	bool owned_;		//< 文件描述符由本对象打开
+	char *map_;			//< 映射地址. NULL表示缓冲模式
+	size_t size_;		//< 映射字节数
+	size_t pos_;		//< 映射模式: 下一行起始位置
+	std::vector<char> buff_;	//< 缓冲区
+	size_t head_, tail_;		//< 缓冲区中未处理数据区间
+	bool eof_;			//< 已读至文件尾
+	int lineno_;		//< 最后输出行的行号, 从1开始
+
+public:
+	/*!
+	 * @brief 打开文件
+	 * @param filepath 文件路径. "-"表示标准输入
+	 * @return
+	 * 打开结果
+	 */
+	bool Open(const char *filepath);
+	/*!
+	 * @brief 关闭文件
+	 */
+	void Close();
+	/*!
+	 * @brief 读取下一行
+	 * @param line 行起始地址
+	 * @param end  行结束地址, 不含换行符
+	 * @return
+	 * 是否读出一行. 文件尾或出错时返回false
+	 */
+	bool NextLine(const char *&line, const char *&end);
+	/*!
+	 * @brief 最后读出行的行号
+	 */
+	int LineNumber() const {
+		return lineno_;
+	}
+	/*!
+	 * @brief 是否为映射模式
+	 */
+	bool IsMapped() const {
+		return map_ != NULL;
+	}
+	/*!
+	 * @brief 映射模式下的文件内容. 缓冲模式下为NULL
+	 */
+	const char *Data() const {
+		return map_;
+	}
+	/*!
+	 * @brief 映射模式下的文件字节数
+	 */
+	size_t Size() const {
+		return size_;
+	}
+
+protected:
+	/*!
+	 * @brief 缓冲模式: 补充数据
+	 * @return
+	 * 是否读取到新的数据
+	 */
+	bool fill_buffer();
+};
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif /* APVREADER_H_ */
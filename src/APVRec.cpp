@@ -6,14 +6,64 @@
  * @date Feb 12, 2019
  */
 #include <stdio.h>
+#include <time.h>
+#include <algorithm>
+#include <boost/assert.hpp>
 #include <boost/make_shared.hpp>
 #include "APVRec.h"
+#include "APVTrace.h"
 
 namespace AstroUtil {
 ///////////////////////////////////////////////////////////////////////////////
+#define COMPACT_MIN		65536	//< 触发数据点存储整理的最小数据点数量
+
+/*
+ * @brief 单调时钟, 量纲: 秒
+ */
+static double rec_now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1E-9;
+}
+
+#ifdef PVREC_PROFILE
+/*
+ * @brief 性能分析: 在作用域内计时, 结束时累加至对应阶段
+ */
+class pv_stage_timer {
+	PVPROFILE &prof_;
+	int stage_;
+	struct timespec t0_;
+
+public:
+	pv_stage_timer(PVPROFILE &prof, int stage) : prof_(prof), stage_(stage) {
+		clock_gettime(CLOCK_MONOTONIC, &t0_);
+	}
+
+	~pv_stage_timer() {
+		struct timespec t1;
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		prof_.elapse[stage_] += (t1.tv_sec - t0_.tv_sec) + (t1.tv_nsec - t0_.tv_nsec) * 1E-9;
+		++prof_.calls[stage_];
+	}
+};
+
+#define PV_PROFILE_STAGE(stage)	pv_stage_timer pv_stage_timer_(prof_, stage)
+#define PV_PROFILE(...)			do { __VA_ARGS__; } while (0)
+#else
+#define PV_PROFILE_STAGE(stage)
+#define PV_PROFILE(...)			do {} while (0)
+#endif
+
 APVRec::APVRec() {
-	camid_ = -1;
-	fno_   = -1;
+	camid_   = -1;
+	fno_     = -1;
+	compact_ = COMPACT_MIN;
+	tracets_ = 0.0;
+	frmmjd_  = 0.0;
+	cadence_ = 0.0;
+	rnewest_ = 0.0;
+	timed_   = false;
 }
 
 APVRec::~APVRec() {
@@ -22,6 +72,7 @@ APVRec::~APVRec() {
 
 void APVRec::SetParam(param_pv &param) {
 	memcpy(&param_, &param, sizeof(param_pv));
+	timed_ = param_.latency || param_.deadline != 0.0;
 }
 
 void APVRec::NewSequence(int camid) {
@@ -29,34 +80,127 @@ void APVRec::NewSequence(int camid) {
 	fno_   = -1;
 	objs_.clear();
 	cans_.clear();
+	frmprev2_.reset();
 	frmprev_.reset();
 	frmlast_.reset();
+	store_.Clear();
+	compact_ = COMPACT_MIN;
+	arena_.Reset();	// 候选体与数据帧均已释放
+	prof_.Reset();
+	lat_.Reset(camid);
+	cadence_ = 0.0;
+	rnewest_ = 0.0;
+	rspare_.insert(rspare_.end(), reorder_.begin(), reorder_.end());
+	reorder_.clear();
+	if (APVTrace::IsEnabled()) tracets_ = APVTrace::Now();
+}
+
+void APVRec::AddPoint(const PVPT &pt) {
+	if (param_.reorder > 0 || param_.reorderdt > 0.0) reorder_point(pt);
+	else add_point(pt);
 }
 
 void APVRec::AddPoint(PPVPT pt) {
-	if (fno_ != pt->fno) {
-		if (fno_ != -1) end_frame();
-		new_frame(pt->mjd);
-		fno_ = pt->fno;
+	AddPoint(*pt);
+}
+
+void APVRec::add_point(const PVPT &pt) {
+	if (fno_ != pt.fno) {
+		if (fno_ != -1) {
+			double t0 = timed_ ? rec_now() : 0.0;
+			end_frame();
+			if (timed_) record_latency(rec_now() - t0, (pt.mjd - frmmjd_) * DAYSEC);
+		}
+		new_frame(pt.mjd);
+		fno_ = pt.fno;
+	}
+	frmlast_->pts.push_back(store_.Append(pt));
+}
+
+void APVRec::reorder_point(const PVPT &pt) {
+	PVRFRM *frm(NULL);
+
+	// 查找所属帧: 通常为最近到达的帧
+	for (int i = int(reorder_.size()) - 1; i >= 0 && !frm; --i) {
+		if (reorder_[i]->fno == pt.fno) frm = reorder_[i].get();
+	}
+	if (!frm) {
+		if (fno_ != -1 && pt.fno == fno_) {// 最近释放的帧尚未结束
+			add_point(pt);
+			return;
+		}
+		if (fno_ != -1 && pt.mjd < frmmjd_) {// 早于已释放帧: 无法插入
+			PV_PROFILE(++prof_.late);
+			return;
+		}
+		if (rspare_.size()) {
+			reorder_.push_back(rspare_.back());
+			rspare_.pop_back();
+		}
+		else reorder_.push_back(boost::make_shared<PVRFRM>());
+		frm = reorder_.back().get();
+		frm->fno = pt.fno;
+		frm->mjd = pt.mjd;
+		frm->pts.clear();
+	}
+	frm->pts.push_back(pt);
+	if (pt.mjd > rnewest_) rnewest_ = pt.mjd;
+	release_frames(false);
+}
+
+void APVRec::release_frames(bool all) {
+	int n, k, i;
+
+	while ((n = reorder_.size())) {
+		for (i = 1, k = 0; i < n; ++i) {// 时标最早的帧. 时标相同时按到达次序
+			if (reorder_[i]->mjd < reorder_[k]->mjd) k = i;
+		}
+		if (!(all
+				|| (param_.reorder > 0 && n > param_.reorder)
+				|| (param_.reorderdt > 0.0 && reorder_[k]->mjd <= rnewest_ - param_.reorderdt)))
+			break;
+
+		PPVRFRM frm = reorder_[k];
+		PV_PROFILE(if (k) ++prof_.reordered);
+		reorder_.erase(reorder_.begin() + k);
+		for (std::vector<PVPT>::iterator it = frm->pts.begin(); it != frm->pts.end(); ++it)
+			add_point(*it);
+		rspare_.push_back(frm);
 	}
-	frmlast_->pts.push_back(pt);
 }
 
 void APVRec::EndSequence() {
+	release_frames(true);
 	if (fno_ != -1) {
+		double t0 = timed_ ? rec_now() : 0.0;
+		PV_PROFILE(profile_frame());
 		recheck_candidates();	// 检查候选体的有效性
+		if (param_.triplet) create_candidates();
 		append_candidates(); 	// 尝试将该帧数据加入候选体
 		complete_candidates();	// 将所有候选体转换为目标
+		if (timed_) record_latency(rec_now() - t0, cadence_);	// 最后一帧沿用前一帧间隔
 	}
 	cans_.clear();
+	frmprev2_.reset();
 	frmprev_.reset();
 	frmlast_.reset();
+	store_.Clear();
+	if (APVTrace::IsEnabled())
+		APVTrace::Record("sequence", tracets_, APVTrace::Now() - tracets_, camid_, -1);
 }
 
 PPVCANVEC& APVRec::GetCandidate() {
 	return cans_;
 }
 
+const APVStore& APVRec::GetStore() {
+	return store_;
+}
+
+const PVARENASTAT& APVRec::GetArenaStat() {
+	return arena_.GetStat();
+}
+
 int APVRec::GetNumber() {
 	return objs_.size();
 }
@@ -66,92 +210,310 @@ PPVOBJVEC& APVRec::GetObject(int &camid) {
 	return objs_;
 }
 
+void APVRec::RegisterObject(const PVObjSlot &slot) {
+	sigobj_.connect(slot);
+}
+
+const PVPROFILE& APVRec::GetProfile() {
+	return prof_;
+}
+
+const PVLATENCY& APVRec::GetLatency() {
+	return lat_;
+}
+
 void APVRec::new_frame(double mjd) {
+	frmmjd_ = mjd;
+	compact_store();
+	if (param_.triplet) frmprev2_ = frmprev_;
 	frmprev_ = frmlast_;
-	frmlast_ = boost::make_shared<PVFRM>(mjd);
+	frmlast_ = boost::allocate_shared<PVFRM>(pv_allocator<PVFRM>(&arena_), mjd, &arena_);
+}
+
+/*
+ * 在new_frame()中调用, 此时frmprev_即将被释放:
+ * 仍被引用的数据点仅包括frmlast_和候选体中的数据点.
+ * 三帧确认时frmprev_继续保留, 释放的是frmprev2_
+ */
+void APVRec::compact_store() {
+	int n = store_.Size();
+	if (n < compact_) return;
+
+	std::vector<char> keep(n, 0);
+	std::vector<int> remap;
+	PVIDXVEC::iterator i;
+
+	if (frmlast_.use_count()) {
+		for (i = frmlast_->pts.begin(); i != frmlast_->pts.end(); ++i) keep[*i] = 1;
+	}
+	if (param_.triplet && frmprev_.use_count()) {
+		for (i = frmprev_->pts.begin(); i != frmprev_->pts.end(); ++i) keep[*i] = 1;
+	}
+	for (PPVCANVEC::iterator it = cans_.begin(); it != cans_.end(); ++it) {
+		for (i = (*it)->pts.begin(); i != (*it)->pts.end(); ++i) keep[*i] = 1;
+	}
+
+	n = store_.Compact(keep, remap);
+	if (frmlast_.use_count()) {
+		for (i = frmlast_->pts.begin(); i != frmlast_->pts.end(); ++i) *i = remap[*i];
+	}
+	if (param_.triplet && frmprev_.use_count()) {
+		for (i = frmprev_->pts.begin(); i != frmprev_->pts.end(); ++i) *i = remap[*i];
+	}
+	for (PPVCANVEC::iterator it = cans_.begin(); it != cans_.end(); ++it) {
+		for (i = (*it)->pts.begin(); i != (*it)->pts.end(); ++i) *i = remap[*i];
+	}
+	if (param_.triplet) frmprev2_.reset();
+	else frmprev_.reset();
+	// 整理后保留的数据点数量翻倍时再次整理
+	compact_ = 2 * n > COMPACT_MIN ? 2 * n : COMPACT_MIN;
+}
+
+void APVRec::record_latency(double elapse, double cadence) {
+	double limit = param_.deadline > 0.0 ? param_.deadline : (param_.deadline < 0.0 ? cadence : 0.0);
+
+	lat_.hist.Record(uint64_t(elapse * 1E6 + 0.5));
+	if (limit > 0.0 && elapse > limit) ++lat_.overrun;
+	cadence_ = cadence;
+}
+
+void APVRec::profile_frame() {
+	int n = frmlast_->pts.size();
+	++prof_.frames;
+	prof_.points += n;
+	if (prof_.frmptmax < n) prof_.frmptmax = n;
 }
 
 void APVRec::end_frame() {
+	PV_PROFILE_STAGE(PVSTAGE_END_FRAME);
+	APVTraceScope trace("end_frame", camid_, fno_);
+	PV_PROFILE(profile_frame());
 	recheck_candidates();	// 检查候选体的有效性, 释放无效候选体
+	if (param_.triplet) create_candidates();	// 由前两帧未关联数据建立经该帧确认的候选体
 	append_candidates(); 	// 尝试将该帧数据加入候选体
-	create_candidates();	// 为未关联数据建立新的候选体
+	if (!param_.triplet) create_candidates();	// 为未关联数据建立新的候选体
 }
 
 void APVRec::create_candidates() {
+	if (param_.triplet) {
+		create_triplets();
+		return;
+	}
 	if (!(frmprev_.unique() && frmlast_.unique())) return;
+	PV_PROFILE_STAGE(PVSTAGE_CREATE);
+	APVTraceScope trace("create_candidates", camid_, fno_);
 
-	PPVPTVEC &pts1 = frmprev_->pts;
-	PPVPTVEC &pts2 = frmlast_->pts;
+	PVIDXVEC &pts1 = frmprev_->pts;
+	PVIDXVEC &pts2 = frmlast_->pts;
+	const double *x = store_.X();
+	const double *y = store_.Y();
 	double stepmin = param_.stepmin;
 	double stepmax = param_.stepmax;
-	double dx, dy;
+	double x1, y1;
+	int n2 = pts2.size(), i;
+
+	// 为最新帧建立网格索引, 网格边长等于最大步长
+	xbuf_.resize(n2);
+	ybuf_.resize(n2);
+	for (i = 0; i < n2; ++i) {
+		xbuf_[i] = x[pts2[i]];
+		ybuf_[i] = y[pts2[i]];
+	}
+	grid_.Build(n2, &xbuf_[0], &ybuf_[0], stepmax);
+
 	// 由相邻帧未关联数据构建候选体
-	for (PPVPTVEC::iterator it1 = pts1.begin(); it1 != pts1.end(); ++it1) {
-		for (PPVPTVEC::iterator it2 = pts2.begin(); it2 != pts2.end(); ++it2) {
-			dx = fabs((*it2)->x - (*it1)->x);
-			dy = fabs((*it2)->y - (*it1)->y);
+	for (PVIDXVEC::iterator it1 = pts1.begin(); it1 != pts1.end(); ++it1) {
+		x1 = x[*it1];
+		y1 = y[*it1];
+		ibuf_.clear();
+		if (!grid_.Match(x1, y1, stepmin, stepmax, ibuf_)) continue;
+		std::sort(ibuf_.begin(), ibuf_.end()); // 保持与帧内数据点相同的次序
+		for (std::vector<int>::iterator it2 = ibuf_.begin(); it2 != ibuf_.end(); ++it2) {
+			PPVCAN can = boost::allocate_shared<PVCAN>(pv_allocator<PVCAN>(&arena_), &store_, &arena_);
+			can->add_point(*it1);
+			can->add_point(pts2[*it2]);
+			cans_.push_back(can);
+			PV_PROFILE(++prof_.created);
+		}
+	}
+	grid_.Reset();
+	PV_PROFILE(if (prof_.cansmax < int(cans_.size())) prof_.cansmax = cans_.size());
+}
 
-			if (stepmin <= dx && dx <= stepmax && stepmin <= dy && dy <= stepmax) {
-				PPVCAN can = boost::make_shared<PVCAN>();
+/*
+ * 与逐帧建立候选体的结果对照:
+ * 数据点对在相邻帧中存在符合append_candidates()判据的数据点时, 才可能扩展为3点以上的候选体.
+ * 三帧确认仅跳过其余数据点对, 但不再为相隔一帧以上(dtmax以内)的数据点建立候选体
+ */
+void APVRec::create_triplets() {
+	if (!(frmprev2_.unique() && frmprev_.unique() && frmlast_.unique())) return;
+	PVIDXVEC &pts1 = frmprev2_->pts;
+	PVIDXVEC &pts2 = frmprev_->pts;
+	PVIDXVEC &pts3 = frmlast_->pts;
+	int n2 = pts2.size(), n3 = pts3.size(), i;
+	if (!(pts1.size() && n2 && n3)) return;
+	PV_PROFILE_STAGE(PVSTAGE_CREATE);
+	APVTraceScope trace("create_candidates", camid_, fno_);
+
+	const double *x = store_.X();
+	const double *y = store_.Y();
+	double stepmin = param_.stepmin;
+	double stepmax = param_.stepmax;
+	double dxy = param_.dxymax;
+	double x1, y1, t1, x2, y2, t2, t, dx, dy;
+	int pt2;
+	bool found;
+
+	// 为最新帧建立网格索引, 网格边长等于位置偏差阈值
+	xbuf_.resize(n3);
+	ybuf_.resize(n3);
+	for (i = 0; i < n3; ++i) {
+		xbuf_[i] = x[pts3[i]];
+		ybuf_[i] = y[pts3[i]];
+	}
+	grid3_.Build(n3, &xbuf_[0], &ybuf_[0], dxy);
+	// 为前一帧建立网格索引, 网格边长等于最大步长
+	xbuf_.resize(n2);
+	ybuf_.resize(n2);
+	for (i = 0; i < n2; ++i) {
+		xbuf_[i] = x[pts2[i]];
+		ybuf_[i] = y[pts2[i]];
+	}
+	grid_.Build(n2, &xbuf_[0], &ybuf_[0], stepmax);
+
+	for (PVIDXVEC::iterator it1 = pts1.begin(); it1 != pts1.end(); ++it1) {
+		x1 = x[*it1];
+		y1 = y[*it1];
+		t1 = store_.MJD(*it1);
+		ibuf_.clear();
+		if (!grid_.Match(x1, y1, stepmin, stepmax, ibuf_)) continue;
+		std::sort(ibuf_.begin(), ibuf_.end()); // 保持与帧内数据点相同的次序
+		for (std::vector<int>::iterator it2 = ibuf_.begin(); it2 != ibuf_.end(); ++it2) {
+			pt2 = pts2[*it2];
+			x2  = x[pt2];
+			y2  = y[pt2];
+			t2  = store_.MJD(pt2);
+			if (t2 <= t1) continue; // 时标相同时无法外推
+			t   = (frmlast_->mjd - t2) / (t2 - t1);
+			// 外推至最新帧, 查找偏差不超过dxymax且步长符合阈值的数据点
+			jbuf_.clear();
+			grid3_.Match(x2 + (x2 - x1) * t, y2 + (y2 - y1) * t, 0.0, dxy, jbuf_);
+			found = false;
+			for (std::vector<int>::iterator it3 = jbuf_.begin(); !found && it3 != jbuf_.end(); ++it3) {
+				dx = fabs(x[pts3[*it3]] - x2);
+				dy = fabs(y[pts3[*it3]] - y2);
+				found = stepmin <= dx && dx <= stepmax && stepmin <= dy && dy <= stepmax;
+			}
+			if (found) {
+				PPVCAN can = boost::allocate_shared<PVCAN>(pv_allocator<PVCAN>(&arena_), &store_, &arena_);
 				can->add_point(*it1);
-				can->add_point(*it2);
+				can->add_point(pt2);
 				cans_.push_back(can);
+				PV_PROFILE(++prof_.created);
 			}
+			else PV_PROFILE(++prof_.unconfirmed);
 		}
 	}
+	grid_.Reset();
+	grid3_.Reset();
+	PV_PROFILE(if (prof_.cansmax < int(cans_.size())) prof_.cansmax = cans_.size());
 }
 
 void APVRec::append_candidates() {
 	if (!cans_.size()) return; // 无候选体立即返回
+	PV_PROFILE_STAGE(PVSTAGE_APPEND);
+	APVTraceScope trace("append_candidates", camid_, fno_);
 
 	double stepmin = param_.stepmin;
 	double stepmax = param_.stepmax;
 	double dxy  = param_.dxymax;
 	double mjd = frmlast_->mjd;
-	double x1, y1, x2, y2, dx1, dy1, dx2, dy2;
-	PPVPTVEC &pts = frmlast_->pts;
-	PPVPT pt;
+	const double *xs = store_.X();
+	const double *ys = store_.Y();
+	double x, y, dx, dy;
+	int ncan = cans_.size(), k, pt;
+	PVIDXVEC &pts = frmlast_->pts;
 	PPVCAN can;
 
 	// 1. 尝试将帧数据追加至候选体
-	for (PPVCANVEC::iterator it = cans_.begin(); it != cans_.end(); ++it) {
-		can = *it;
-		// 候选体最后一个点的坐标
-		pt = can->last_point();
-		x1 = pt->x;
-		y1 = pt->y;
-		for (PPVPTVEC::iterator i = pts.begin(); i != pts.end(); ++i) {// 与当前帧数据交叉比对
-			dx1 = fabs(x1 - (*i)->x);
-			dy1 = fabs(y1 - (*i)->y);
-			if (stepmin <= dx1 && dx1 <= stepmax && stepmin <= dy1 && dy1 <= stepmax) {// 位置变化步长未超出阈值
-				if (can->xy_expect(mjd, x2, y2)) {// 预测位置与测量位置偏差未超出阈值
-					dx2 = fabs(x2 - (*i)->x);
-					dy2 = fabs(y2 - (*i)->y);
-					if (dx2 <= dxy && dy2 <= dxy){
-						can->add_point(*i);
-					}
-				}
-				else {
-					can->add_point(*i);
-				}
+	// 1.1 计算候选体在当前帧时标的预测位置, 并建立网格索引.
+	// 候选体建立时即含两个数据点, 因此均可预测位置.
+	// 前两点时标相同时速度为无穷大, 预测位置非有限值, 逐个比对时不可能匹配: 不参与索引
+	xbuf_.resize(ncan);
+	ybuf_.resize(ncan);
+	jbuf_.clear();
+	for (k = 0; k < ncan; ++k) {
+		bool rslt = cans_[k]->xy_expect(mjd, x, y);
+		BOOST_ASSERT(rslt);
+		(void) rslt;
+		if (isfinite(x) && isfinite(y)) {
+			xbuf_[jbuf_.size()] = x;
+			ybuf_[jbuf_.size()] = y;
+			jbuf_.push_back(k);
+		}
+	}
+	grid_.Build(jbuf_.size(), &xbuf_[0], &ybuf_[0], dxy);
+	// 1.2 由预测位置查找与帧数据匹配的候选体: 预测位置与测量位置偏差未超出阈值
+	for (PVIDXVEC::iterator i = pts.begin(); i != pts.end(); ++i) {// 与候选体交叉比对
+		x = xs[*i];
+		y = ys[*i];
+		ibuf_.clear();
+		if (!grid_.Match(x, y, 0.0, dxy, ibuf_)) continue;
+		for (std::vector<int>::iterator j = ibuf_.begin(); j != ibuf_.end(); ++j) {
+			can = cans_[jbuf_[*j]];
+			pt  = can->last_point();
+			dx  = fabs(xs[pt] - x);
+			dy  = fabs(ys[pt] - y);
+			if (stepmin <= dx && dx <= stepmax && stepmin <= dy && dy <= stepmax) {// 位置变化步长未超出阈值
+				can->add_point(*i);
 			}
 		}
 	}
+	grid_.Reset();
 	// 2. 将确定帧数据加入候选体
-	for (PPVCANVEC::iterator it = cans_.begin(); it != cans_.end(); ++it) {
-		pt = (*it)->update();
+	// 末端两点相同的候选体, 其预测位置及后续关联结果完全相同: 仅保留数据点较多者
+	int ndup(0);
+	if (param_.dedup) tails_.clear();
+	for (k = 0; k < ncan; ++k) {
+		can = cans_[k];
+		pt  = can->update();
 
-		if (pt.use_count()) {// 通知数据库, 构成弧段的数据点
-			if ((*it)->pts.size() == 3) {// 通知数据库, 构成弧段的前两个数据点
+		if (pt >= 0) {// 通知数据库, 构成弧段的数据点
+			PV_PROFILE(++prof_.extended);
+			if (can->pts.size() == 3) {// 通知数据库, 构成弧段的前两个数据点
 
 			}
+			if (param_.dedup) {
+				uint64_t key = (uint64_t(uint32_t(can->pts[can->pts.size() - 2])) << 32) | uint32_t(pt);
+				std::pair<PVTAILMAP::iterator, bool> rslt = tails_.insert(PVTAILMAP::value_type(key, k));
+				if (!rslt.second) {// 与先前的候选体重复
+					int &kept = rslt.first->second, drop(k);
+					if (cans_[kept]->pts.size() < can->pts.size()) {
+						drop = kept;
+						kept = k;
+					}
+					cans_[drop].reset();
+					++ndup;
+				}
+			}
 		}
 	}
+	if (ndup) {// 移出重复的候选体, 保持其余候选体的次序
+		PPVCANVEC::iterator it, itkeep = cans_.begin();
+		for (it = cans_.begin(); it != cans_.end(); ++it) {
+			if (!it->use_count()) continue;
+			if (itkeep != it) itkeep->swap(*it);
+			++itkeep;
+		}
+		cans_.erase(itkeep, cans_.end());
+		PV_PROFILE(prof_.merged += ndup);
+	}
 	// 3. 剔除已加入候选体的数据点
-	for (PPVPTVEC::iterator it = pts.begin(); it != pts.end(); ) {
-		if ((*it)->related) it = pts.erase(it);
-		else ++it;
+	int n(0);
+	for (PVIDXVEC::iterator it = pts.begin(); it != pts.end(); ++it) {
+		if (!store_.related(*it)) pts[n++] = *it;
 	}
+	pts.resize(n);
 	if (!pts.size()) frmlast_.reset();
 }
 
@@ -162,39 +524,53 @@ void APVRec::append_candidates() {
  */
 void APVRec::recheck_candidates() {
 	if (cans_.size()) {
+		PV_PROFILE_STAGE(PVSTAGE_RECHECK);
+		APVTraceScope trace("recheck_candidates", camid_, fno_);
 		int    nptmin = param_.nptmin;
 		double dtmax  = param_.dtmax;
 		double mjd    = frmlast_->mjd;
 		double dt;
 
-		for (PPVCANVEC::iterator it = cans_.begin(); it != cans_.end();) {
+		PPVCANVEC::iterator it, itkeep = cans_.begin();
+
+		for (it = cans_.begin(); it != cans_.end(); ++it) {
 			dt = mjd - (*it)->lastmjd;
-			if (0 < dt && dt <= dtmax) ++it; // 保留. dt > 0: 原始数据未按时间严格排序
-			else {// 移出候选体集合
-				if ((*it)->pts.size() >= nptmin) candidate2object(*it); // 转换为目标
-				it = cans_.erase(it);
+			if (0 < dt && dt <= dtmax) {// 保留. dt > 0: 原始数据未按时间严格排序
+				if (itkeep != it) itkeep->swap(*it);
+				++itkeep;
 			}
+			else if ((*it)->pts.size() >= nptmin) candidate2object(*it); // 转换为目标
+			else PV_PROFILE(++prof_.discarded);
 		}
+		// 一次性移出无效候选体. 逐个erase()时stable_vector需重复修正节点指针
+		cans_.erase(itkeep, cans_.end());
 	}
 }
 
 void APVRec::complete_candidates() {
+	PV_PROFILE_STAGE(PVSTAGE_COMPLETE);
+	APVTraceScope trace("complete_candidates", camid_, fno_);
 	int nptmin = param_.nptmin;
 
 	for (PPVCANVEC::iterator it = cans_.begin(); it != cans_.end(); ++it) {
 		if ((*it)->pts.size() >= nptmin) candidate2object(*it);
+		else PV_PROFILE(++prof_.discarded);
 	}
 }
 
 void APVRec::candidate2object(PPVCAN can) {
-	PPVPTVEC & pts = can->pts;
+	PV_PROFILE(++prof_.promoted);
+	PVIDXVEC &pts = can->pts;
 	PPVOBJ obj = boost::make_shared<PVOBJ>();
 	PPVPTVEC &npts = obj->pts;
 
-	for (PPVPTVEC::iterator it = pts.begin(); it != pts.end(); ++it) {
-		npts.push_back(*it);
+	for (PVIDXVEC::iterator it = pts.begin(); it != pts.end(); ++it) {
+		PPVPT pt = boost::make_shared<PVPT>();
+		store_.Point(*it, *pt);
+		npts.push_back(pt);
 	}
-	objs_.push_back(obj);
+	if (sigobj_.empty()) objs_.push_back(obj);
+	else sigobj_(camid_, obj);	// 流式处理: 立即输出, 不保存
 }
 ///////////////////////////////////////////////////////////////////////////////
 }
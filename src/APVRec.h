@@ -18,6 +18,20 @@
  * (8) GetObject(),     查看某一目标的详细信息
  *
  * @note
+ * 流式处理: 调用RegisterObject()注册回调函数后, 候选体转换为目标时立即回调,
+ * 目标不再保存在APVRec中, GetNumber()/GetObject()不再返回这些目标
+ *
+ * @note
+ * 性能分析: 编译时定义PVREC_PROFILE(-DPVREC_PROFILE)后, 记录各阶段耗时、调用次数及候选体计数,
+ * 由GetProfile()查看. 未定义时相关代码不参与编译, GetProfile()返回全零
+ *
+ * @note
+ * 乱序输入: param_pv::reorder或reorderdt非零时, AddPoint()先将数据点按帧编号存入重排缓冲区,
+ * 再按时标次序释放完整的帧. 缓冲帧数超过reorder, 或帧时标不晚于低水位线(最新时标-reorderdt)时释放.
+ * 时标早于已释放帧的数据点视为迟到并丢弃; 属于最近释放帧的数据点仍追加至该帧.
+ * EndSequence()释放所有缓冲帧
+ *
+ * @note
  * 遗留问题(2016年9月26日):
  * (1) 单目标被拆分识别为多个目标(文件)  ==> 合并线段, 要做非线性合并, 暂放弃(Sep 26, 2016)
  * (2) 漏点: 中间某些帧中数据未被正确识别并关联  <== 判据 (待采用时间作为帧间判据, 测试决定后续算法)
@@ -27,11 +41,19 @@
 #ifndef APVREC_H_
 #define APVREC_H_
 
+#include <stdint.h>
 #include <string.h>
+#include <vector>
 #include <boost/smart_ptr.hpp>
+#include <boost/signals2.hpp>
+#include <boost/unordered_map.hpp>
 #include <boost/container/stable_vector.hpp>
 #include <boost/container/deque.hpp>
 #include "ADefine.h"
+#include "APVArena.h"
+#include "APVGrid.h"
+#include "APVHist.h"
+#include "APVStore.h"
 
 namespace AstroUtil {
 ///////////////////////////////////////////////////////////////////////////////
@@ -41,6 +63,12 @@ struct param_pv {// 位置变源关联识别参数
 	double stepmin;	//< 最小步长
 	double stepmax;	//< 最大步长
 	double dxymax;	//< XY坐标偏差的最大值, 量纲: 像素
+	double deadline;//< 单帧处理时限, 量纲: 秒. 0: 不检查; 负数: 以该帧与下一帧的时间间隔为时限
+	bool latency;	//< 记录单帧处理延迟. deadline非零时亦记录
+	bool dedup;		//< 候选体去重: 末端两点相同的候选体仅保留数据点较多者. 缺省关闭, 开启后识别结果可能减少
+	bool triplet;	//< 三帧确认: 相邻两帧数据点外推至第三帧, 存在匹配数据点时才建立候选体
+	int reorder;	//< 重排缓冲区的最大帧数. 0: 不限帧数
+	double reorderdt;	//< 重排缓冲区的时间窗口, 量纲: 天. 0: 不限时间. 与reorder均为0时不重排
 
 public:
 	param_pv() {
@@ -49,6 +77,12 @@ public:
 		stepmin = 1.0;
 		stepmax = 100.0;
 		dxymax  = 5.0;
+		deadline = 0.0;
+		latency  = false;
+		dedup    = false;
+		triplet  = false;
+		reorder  = 0;
+		reorderdt = 0.0;
 	}
 };
 
@@ -75,17 +109,19 @@ public:
 }PVPT;
 typedef boost::shared_ptr<PVPT> PPVPT;
 typedef boost::container::stable_vector<PPVPT> PPVPTVEC;
+typedef std::vector<int, pv_allocator<int> > PVIDXVEC;	//< 数据点序号数组
 
 typedef struct pv_frame {// 单帧数据共性属性及数据点集合
 	double mjd;		//< 曝光中间时间对应的修正儒略日
-	PPVPTVEC pts;	//< 数据点集合
+	PVIDXVEC pts;	//< 数据点在APVStore中的序号
 
 public:
 	pv_frame() {
 		mjd = 0.0;
 	}
 
-	pv_frame(double Mjd) {
+	pv_frame(double Mjd, APVArena *arena = NULL)
+		: pts(pv_allocator<int>(arena)) {
 		mjd = Mjd;
 	}
 
@@ -96,31 +132,48 @@ public:
 typedef boost::shared_ptr<PVFRM> PPVFRM;
 typedef boost::container::deque<PPVFRM> PPVFRMDQ;
 
+typedef struct pv_reorder_frame {// 重排缓冲区中的一帧: 释放前按帧编号组合数据点
+	int fno;		//< 帧编号
+	double mjd;		//< 首个数据点的修正儒略日
+	std::vector<PVPT> pts;	//< 数据点
+}PVRFRM;
+typedef boost::shared_ptr<PVRFRM> PPVRFRM;
+typedef std::vector<PPVRFRM> PPVRFRMVEC;
+
 /*
  * pv_candidate使用流程:
  * 1. 构建对象
  * 2. xy_expect(): 评估输出的xy与数据点之间的偏差是否符合阈值
  * 3. add_point(): 将数据点加入候选体
  * 4. recheck_frame(): 在EndFrame()中评估当前帧数据点是否为候选体提供有效数据
+ *
+ * 数据点以其在APVStore中的序号引用
  */
 typedef struct pv_candidate {// 候选体
-	PPVPTVEC pts;	//< 已确定数据点集合
-	PPVPTVEC frmu;	//< 由当前帧加入的不确定数据点
+	APVStore *store;	//< 数据点存储
+	PVIDXVEC pts;	//< 已确定数据点集合
+	PVIDXVEC frmu;	//< 由当前帧加入的不确定数据点
 	double vx, vy;	//< XY变化速度
 	double lastmjd;	//< 加入候选体的最后一个数据点对应的时间, 量纲: 天; 涵义: 修正儒略日
 
 public:
-	PPVPT last_point() {// 构成候选体的最后一个数据点
+	pv_candidate(APVStore *Store, APVArena *arena = NULL)
+		: pts(pv_allocator<int>(arena)), frmu(pv_allocator<int>(arena)) {
+		store = Store;
+		vx = vy = lastmjd = 0.0;
+	}
+
+	int last_point() {// 构成候选体的最后一个数据点
 		return pts[pts.size() - 1];
 	}
 
 	bool xy_expect(double mjd, double &x, double &y) {// 由候选体已知(加)速度计算其预测位置
 		int n = pts.size();
 		if (n >= 2) {
-			PPVPT pt = last_point();
-			double t = mjd - pt->mjd;
-			x = pt->x + vx * t;
-			y = pt->y + vy * t;
+			int pt = last_point();
+			double t = mjd - store->MJD(pt);
+			x = store->X(pt) + vx * t;
+			y = store->Y(pt) + vy * t;
 		}
 		return (n >= 2);
 	}
@@ -128,50 +181,50 @@ public:
 	/*!
 	 * @brief 将一个数据点加入候选体
 	 */
-	void add_point(PPVPT pt) {
+	void add_point(int pt) {
 		if (pts.size() >= 2){// 构成候选体的候选点
-			pt->inc_rel();
+			store->inc_rel(pt);
 			frmu.push_back(pt);
 		}
 		else {// 构成候选体的初始2点
 			pts.push_back(pt);
 			if (pts.size() == 2) {
-				PPVPT prev = pts[0];
-				double t = (lastmjd = pt->mjd) - prev->mjd;
-				vx = (pt->x - prev->x) / t;
-				vy = (pt->y - prev->y) / t;
+				int prev = pts[0];
+				double t = (lastmjd = store->MJD(pt)) - store->MJD(prev);
+				vx = (store->X(pt) - store->X(prev)) / t;
+				vy = (store->Y(pt) - store->Y(prev)) / t;
 			}
 		}
 	}
 
-	PPVPT update() {// 检查/确认来自当前帧的数据点是否加入候选体已确定数据区
-		PPVPT pt;
+	int update() {// 检查/确认来自当前帧的数据点是否加入候选体已确定数据区
+		int pt(-1);
 		double x, y;	// 期望位置
 		double dx, dy, dx2y2, dx2y2max(1E30);
 		if (!frmu.size() || pts.size() < 2) return pt;
 
-		lastmjd = frmu[0]->mjd;
+		lastmjd = store->MJD(frmu[0]);
 		if (xy_expect(lastmjd, x, y)) {
 			/*
 			 * 该算法解决: 多点加入一个候选体时带来的混淆
 			 */
-			for (PPVPTVEC::iterator it = frmu.begin(); it != frmu.end(); ++it) {// 查找与候选体末端最接近的数据
-				dx = (*it)->x - x;
-				dy = (*it)->y - y;
+			for (PVIDXVEC::iterator it = frmu.begin(); it != frmu.end(); ++it) {// 查找与候选体末端最接近的数据
+				dx = store->X(*it) - x;
+				dy = store->Y(*it) - y;
 				dx2y2 = dx * dx + dy * dy;
 				if (dx2y2 < dx2y2max) {
-					if (pt.use_count()) pt->dec_rel();
+					if (pt >= 0) store->dec_rel(pt);
 
 					dx2y2max = dx2y2;
 					pt = *it;
 				}
 			}
 
-			if (pt.use_count()) {// 将距离偏差最小的数据点加入候选体
-				PPVPT last = last_point();
-				double t   = lastmjd - last->mjd;
-				vx = (pt->x - last->x) / t;
-				vy = (pt->y - last->y) / t;
+			if (pt >= 0) {// 将距离偏差最小的数据点加入候选体
+				int last = last_point();
+				double t = lastmjd - store->MJD(last);
+				vx = (store->X(pt) - store->X(last)) / t;
+				vy = (store->Y(pt) - store->Y(last)) / t;
 				pts.push_back(pt);
 			}
 		}
@@ -185,12 +238,106 @@ public:
 }PVCAN;
 typedef boost::shared_ptr<PVCAN> PPVCAN;
 typedef boost::container::stable_vector<PPVCAN> PPVCANVEC;
+typedef boost::unordered_map<uint64_t, int> PVTAILMAP;	//< 候选体末端两点 -> 候选体序号
 
 typedef struct pv_object {// PV目标
 	PPVPTVEC pts;	//< 已确定数据点集合
 }PVOBJ;
 typedef boost::shared_ptr<PVOBJ> PPVOBJ;
 typedef boost::container::stable_vector<PPVOBJ> PPVOBJVEC;
+/*!
+ * @brief 回调函数: 识别出一个目标
+ * @param 1 相机编号
+ * @param 2 目标
+ */
+typedef boost::signals2::signal<void (int, const PPVOBJ&)> PVObjSignal;
+typedef PVObjSignal::slot_type PVObjSlot;
+
+enum {// 性能分析: 计时阶段
+	PVSTAGE_END_FRAME,	//< end_frame(), 含其调用的recheck/append/create
+	PVSTAGE_CREATE,		//< create_candidates()
+	PVSTAGE_APPEND,		//< append_candidates()
+	PVSTAGE_RECHECK,	//< recheck_candidates()
+	PVSTAGE_COMPLETE,	//< complete_candidates()
+	PVSTAGE_MAX
+};
+
+typedef struct pv_profile {// 性能分析: 分阶段计时与计数
+	double elapse[PVSTAGE_MAX];	//< 累计耗时, 量纲: 秒
+	long calls[PVSTAGE_MAX];	//< 调用次数
+	long created;	//< 建立的候选体数量
+	long extended;	//< 候选体追加数据点的次数
+	long promoted;	//< 转换为目标的候选体数量
+	long discarded;	//< 剔除的候选体数量
+	long merged;	//< 去重时剔除的候选体数量
+	long unconfirmed;	//< 三帧确认时未通过的数据点对数量
+	long reordered;	//< 重排缓冲区未按到达次序释放的帧数
+	long late;		//< 重排缓冲区丢弃的迟到数据点数量
+	long frames;	//< 帧数
+	long points;	//< 数据点数量
+	int frmptmax;	//< 单帧最大数据点数量
+	int cansmax;	//< 候选体集合的最大规模
+
+public:
+	pv_profile() {
+		Reset();
+	}
+
+	void Reset() {
+		memset(this, 0, sizeof(pv_profile));
+	}
+
+	pv_profile &operator+=(const pv_profile &x) {// 累加. 最大值取二者中的较大者
+		for (int i = 0; i < PVSTAGE_MAX; ++i) {
+			elapse[i] += x.elapse[i];
+			calls[i]  += x.calls[i];
+		}
+		created   += x.created;
+		extended  += x.extended;
+		promoted  += x.promoted;
+		discarded += x.discarded;
+		merged    += x.merged;
+		unconfirmed += x.unconfirmed;
+		reordered += x.reordered;
+		late      += x.late;
+		frames    += x.frames;
+		points    += x.points;
+		if (frmptmax < x.frmptmax) frmptmax = x.frmptmax;
+		if (cansmax  < x.cansmax)  cansmax  = x.cansmax;
+		return *this;
+	}
+
+	static const char *StageName(int stage) {
+		static const char *name[] = {
+			"end_frame", "create", "append", "recheck", "complete"
+		};
+		return stage >= 0 && stage < PVSTAGE_MAX ? name[stage] : "";
+	}
+}PVPROFILE;
+
+typedef struct pv_latency {// 单帧处理延迟统计
+	int camid;		//< 相机编号
+	APVHist hist;	//< 单帧处理时间直方图, 量纲: 微秒
+	long overrun;	//< 处理时间超出时限的帧数
+
+public:
+	pv_latency() {
+		camid   = -1;
+		overrun = 0;
+	}
+
+	void Reset(int Camid) {
+		camid   = Camid;
+		overrun = 0;
+		hist.Reset();
+	}
+
+	pv_latency &operator+=(const pv_latency &x) {
+		hist += x.hist;
+		overrun += x.overrun;
+		return *this;
+	}
+}PVLATENCY;
 
 class APVRec {
 public:
@@ -201,10 +348,29 @@ protected:
 	param_pv param_;	//< 数据处理参数
 	int camid_;			//< 该批次数据使用的相机编号
 	int fno_;			//< 最新数据帧编号
+	APVArena arena_;	//< 本批次内存池: 数据帧与候选体
+	APVStore store_;	//< 本批次数据点存储
+	int compact_;		//< 数据点存储整理阈值
+	PPVFRM frmprev2_;	//< 前二数据帧. 仅用于三帧确认
 	PPVFRM frmprev_;	//< 前一数据帧
 	PPVFRM frmlast_;	//< 最新数据帧
 	PPVCANVEC cans_;	//< 候选体集合
 	PPVOBJVEC objs_;	//< 目标集合
+	APVGrid grid_;		//< 网格索引: 最新帧数据点或候选体预测位置
+	APVGrid grid3_;		//< 网格索引: 三帧确认时的最新帧数据点
+	std::vector<double> xbuf_, ybuf_;	//< 建立索引使用的XY坐标缓存
+	std::vector<int> ibuf_, jbuf_;		//< 索引查找结果缓存
+	PVTAILMAP tails_;	//< 候选体去重使用的散列表, 键为末端两点在APVStore中的序号
+	PVObjSignal sigobj_;	//< 回调函数: 识别出一个目标
+	PVPROFILE prof_;		//< 性能分析: 本批次的计时与计数
+	double tracets_;		//< 时间线: 本批次起始时间, 见APVTrace
+	PVLATENCY lat_;			//< 本批次单帧处理延迟
+	double frmmjd_;			//< 最新帧的修正儒略日
+	double cadence_;		//< 最近的帧间隔, 量纲: 秒
+	bool timed_;			//< 记录单帧处理延迟: param_pv::latency或deadline非零
+	PPVRFRMVEC reorder_;	//< 重排缓冲区: 未释放的帧, 按到达次序排列
+	PPVRFRMVEC rspare_;		//< 重排缓冲区: 已释放待复用的帧
+	double rnewest_;		//< 重排缓冲区: 已到达数据点的最新时标
 
 public:
 	/*!
@@ -217,7 +383,10 @@ public:
 	void NewSequence(int camid);
 	/*!
 	 * @brief 添加一个数据点
+	 * @note
+	 * 数据点被复制到本批次的列存储中
 	 */
+	void AddPoint(const PVPT &pt);
 	void AddPoint(PPVPT pt);
 	/*!
 	 * @brief 结束一个批次数据处理流程
@@ -227,6 +396,14 @@ public:
 	 * @brief 查看候选体
 	 */
 	PPVCANVEC& GetCandidate();
+	/*!
+	 * @brief 查看本批次数据点存储. 候选体以序号引用其中的数据点
+	 */
+	const APVStore& GetStore();
+	/*!
+	 * @brief 查看本批次内存池统计信息
+	 */
+	const PVARENASTAT& GetArenaStat();
 	/*!
 	 * @brief 查看被识别的目标数量
 	 */
@@ -235,24 +412,80 @@ public:
 	 * @brief 查看被识别的目标
 	 */
 	PPVOBJVEC& GetObject(int &camid);
+	/*!
+	 * @brief 注册回调函数: 识别出一个目标
+	 * @note
+	 * 注册后, 目标在候选体被确认时立即通过回调函数输出, 并随后释放
+	 */
+	void RegisterObject(const PVObjSlot &slot);
+	/*!
+	 * @brief 查看本批次的性能分析数据. 由NewSequence()清零
+	 */
+	const PVPROFILE& GetProfile();
+	/*!
+	 * @brief 查看本批次的单帧处理延迟统计
+	 * @note
+	 * 单帧处理时间指结束一帧时end_frame()的耗时. 最后一帧含complete_candidates().
+	 * 由NewSequence()清零, EndSequence()后包含所有帧.
+	 * 仅当param_pv::latency为true或deadline非零时记录, 否则为空
+	 */
+	const PVLATENCY& GetLatency();
 
 protected:
+	/*!
+	 * @brief 将数据点加入最新帧. 帧编号变化时结束前一帧
+	 */
+	void add_point(const PVPT &pt);
+	/*!
+	 * @brief 将数据点存入重排缓冲区, 并释放满足条件的帧
+	 */
+	void reorder_point(const PVPT &pt);
+	/*!
+	 * @brief 按时标次序释放重排缓冲区中的帧
+	 * @param all 是否释放所有帧
+	 */
+	void release_frames(bool all);
 	/*!
 	 * @brief 准备处理同一帧图像的数据
 	 */
 	void new_frame(double mjd);
+	/*!
+	 * @brief 剔除数据点存储中不再被帧或候选体引用的数据点
+	 */
+	void compact_store();
+	/*!
+	 * @brief 记录一帧的处理时间
+	 * @param elapse  处理时间, 量纲: 秒
+	 * @param cadence 帧间隔, 量纲: 秒
+	 */
+	void record_latency(double elapse, double cadence);
+	/*!
+	 * @brief 性能分析: 记录最新帧的数据点数量
+	 */
+	void profile_frame();
 	/*!
 	 * @brief 结束同一帧数据
 	 */
 	void end_frame();
 	/*!
 	 * @brief 建立新的候选体
+	 * @note
+	 * 三帧确认时在append_candidates()之前调用: 由前两帧的未关联数据建立候选体,
+	 * 新候选体随即参与最新帧数据的追加.
+	 * 虚函数: 一致性检查以逐一比对的原算法替代, 见pvbench.cpp
 	 */
-	void create_candidates();
+	virtual void create_candidates();
+	/*!
+	 * @brief 三帧确认: 前两帧未关联数据构成的数据点对外推至最新帧,
+	 * 预测位置偏差不超过dxymax且步长符合阈值时建立候选体
+	 */
+	void create_triplets();
 	/*!
 	 * @brief 尝试将当前帧数据加入候选体
+	 * @note
+	 * 虚函数: 一致性检查以逐一比对的原算法替代, 见pvbench.cpp
 	 */
-	void append_candidates();
+	virtual void append_candidates();
 	/*!
 	 * @brief 检查候选体, 确认其有效性
 	 * @note
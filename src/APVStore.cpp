@@ -0,0 +1,83 @@
+/*
+ * @file APVStore.cpp 类APVStore的定义文件
+ * @version 0.1
+ * @date Oct 17, 2026
+ */
+#include "APVRec.h"
+#include "APVStore.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+APVStore::APVStore() {
+}
+
+APVStore::~APVStore() {
+}
+
+void APVStore::Clear() {
+	x_.clear();
+	y_.clear();
+	mjd_.clear();
+	fno_.clear();
+	related_.clear();
+	ra_.clear();
+	dc_.clear();
+	mag_.clear();
+}
+
+int APVStore::Append(const pv_point &pt) {
+	x_.push_back(pt.x);
+	y_.push_back(pt.y);
+	mjd_.push_back(pt.mjd);
+	fno_.push_back(pt.fno);
+	related_.push_back(0);
+	ra_.push_back(pt.ra);
+	dc_.push_back(pt.dc);
+	mag_.push_back(pt.mag);
+	return (x_.size() - 1);
+}
+
+void APVStore::Point(int i, pv_point &pt) const {
+	pt.related = related_[i];
+	pt.fno     = fno_[i];
+	pt.mjd     = mjd_[i];
+	pt.x       = x_[i];
+	pt.y       = y_[i];
+	pt.ra      = ra_[i];
+	pt.dc      = dc_[i];
+	pt.mag     = mag_[i];
+}
+
+int APVStore::Compact(const std::vector<char> &keep, std::vector<int> &remap) {
+	int n = Size(), i, j;
+
+	remap.resize(n);
+	for (i = j = 0; i < n; ++i) {
+		if (!keep[i]) remap[i] = -1;
+		else {
+			if (i != j) {
+				x_[j]       = x_[i];
+				y_[j]       = y_[i];
+				mjd_[j]     = mjd_[i];
+				fno_[j]     = fno_[i];
+				related_[j] = related_[i];
+				ra_[j]      = ra_[i];
+				dc_[j]      = dc_[i];
+				mag_[j]     = mag_[i];
+			}
+			remap[i] = j++;
+		}
+	}
+	x_.resize(j);
+	y_.resize(j);
+	mjd_.resize(j);
+	fno_.resize(j);
+	related_.resize(j);
+	ra_.resize(j);
+	dc_.resize(j);
+	mag_.resize(j);
+
+	return j;
+}
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,89 @@
+/*
+ * @file APVStore.h 类APVStore的声明文件
+ * APVStore -- 数据点列存储. 一个批次(NewSequence()..EndSequence())的数据点
+ * 按到达次序存储于连续数组, 以序号引用
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * - 关联比对仅访问x/y/mjd/related列, ra/dc/mag/fno列仅在生成目标时访问
+ * - Compact()剔除不再被引用的数据点, 调用者依据映射表更新序号
+ */
+
+#ifndef APVSTORE_H_
+#define APVSTORE_H_
+
+#include <vector>
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+struct pv_point;
+
+class APVStore {
+public:
+	APVStore();
+	virtual ~APVStore();
+
+protected:
+	std::vector<double> x_, y_;	//< 星象质心在模板中的位置
+	std::vector<double> mjd_;	//< 曝光中间时间对应的修正儒略日
+	std::vector<int> fno_;		//< 帧编号
+	std::vector<int> related_;	//< 被关联次数
+	std::vector<double> ra_, dc_;	//< 赤道坐标, 量纲: 角度
+	std::vector<double> mag_;	//< 星等
+
+public:
+	/*!
+	 * @brief 清除所有数据点
+	 */
+	void Clear();
+	/*!
+	 * @brief 追加一个数据点
+	 * @return
+	 * 数据点序号
+	 */
+	int Append(const pv_point &pt);
+	/*!
+	 * @brief 数据点数量
+	 */
+	int Size() const {
+		return x_.size();
+	}
+	/*!
+	 * @brief 按序号生成单数据点
+	 */
+	void Point(int i, pv_point &pt) const;
+	/*!
+	 * @brief 剔除未标记保留的数据点
+	 * @param keep  保留标记, 长度等于Size()
+	 * @param remap 序号映射表: 原序号->新序号, 被剔除数据点为-1
+	 * @return
+	 * 剔除后数据点数量
+	 */
+	int Compact(const std::vector<char> &keep, std::vector<int> &remap);
+
+public:
+	/* 列访问. 追加数据点后原指针失效 */
+	const double *X() const { return &x_[0]; }
+	const double *Y() const { return &y_[0]; }
+	const double *MJD() const { return &mjd_[0]; }
+	double X(int i) const { return x_[i]; }
+	double Y(int i) const { return y_[i]; }
+	double MJD(int i) const { return mjd_[i]; }
+
+	int inc_rel(int i) {// 增加一次关联次数
+		return ++related_[i];
+	}
+
+	int dec_rel(int i) {// 减少一次关联次数
+		return --related_[i];
+	}
+
+	int related(int i) const {
+		return related_[i];
+	}
+};
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif /* APVSTORE_H_ */
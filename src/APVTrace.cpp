@@ -0,0 +1,150 @@
+/*
+ * @file APVTrace.cpp 类APVTrace的定义文件
+ * @version 0.1
+ * @date Oct 17, 2026
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <boost/thread/tss.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/smart_ptr.hpp>
+#include "APVTrace.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+/*
+ * @brief 线程环形缓冲区
+ */
+struct pv_trace_ring {
+	int tid;			//< 线程序号
+	std::string name;	//< 线程名称
+	std::vector<PVTRACEEVENT> events;	//< 事件
+	unsigned long count;	//< 累计记录的事件数量
+
+public:
+	pv_trace_ring(int Tid) : events(APVTrace::RING_SIZE) {
+		tid   = Tid;
+		count = 0;
+	}
+};
+typedef boost::shared_ptr<pv_trace_ring> PVTRACERING;
+
+bool APVTrace::enabled_ = false;
+static struct timespec trace_t0;	//< 时间零点
+static boost::mutex trace_mtx;		//< 互斥锁: 缓冲区登记
+static std::vector<PVTRACERING> trace_rings;	//< 所有线程的缓冲区
+/*
+ * 线程结束后缓冲区仍由trace_rings持有, 供Write()输出
+ */
+static void trace_ring_release(pv_trace_ring *) {
+}
+static boost::thread_specific_ptr<pv_trace_ring> trace_ring(trace_ring_release);
+
+/*
+ * @brief 调用线程的缓冲区. 首次调用时登记
+ */
+static pv_trace_ring *thread_ring() {
+	pv_trace_ring *ring = trace_ring.get();
+	if (!ring) {
+		boost::mutex::scoped_lock lck(trace_mtx);
+		PVTRACERING p = boost::make_shared<pv_trace_ring>(int(trace_rings.size()) + 1);
+		trace_rings.push_back(p);
+		trace_ring.reset(ring = p.get());
+	}
+	return ring;
+}
+
+void APVTrace::Enable() {
+	clock_gettime(CLOCK_MONOTONIC, &trace_t0);
+	enabled_ = true;
+}
+
+double APVTrace::Now() {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (t.tv_sec - trace_t0.tv_sec) * 1E6 + (t.tv_nsec - trace_t0.tv_nsec) * 1E-3;
+}
+
+void APVTrace::SetThreadName(const char *name) {
+	if (enabled_) thread_ring()->name = name;
+}
+
+void APVTrace::Record(const char *name, double ts, double dur, int camid, int fno, const char *detail) {
+	pv_trace_ring *ring = thread_ring();
+	PVTRACEEVENT &e = ring->events[ring->count++ % RING_SIZE];
+
+	e.name  = name;
+	e.ts    = ts;
+	e.dur   = dur;
+	e.camid = camid;
+	e.fno   = fno;
+	if (detail) {
+		strncpy(e.detail, detail, sizeof(e.detail) - 1);
+		e.detail[sizeof(e.detail) - 1] = 0;
+	}
+	else e.detail[0] = 0;
+}
+
+/*
+ * @brief 输出JSON字符串, 转义引号、反斜杠及控制字符
+ */
+static void write_string(FILE *fp, const char *s) {
+	fputc('"', fp);
+	for (; *s; ++s) {
+		if (*s == '"' || *s == '\\') fprintf(fp, "\\%c", *s);
+		else if ((unsigned char) *s < 0x20) fprintf(fp, "\\u%04x", *s);
+		else fputc(*s, fp);
+	}
+	fputc('"', fp);
+}
+
+int APVTrace::Write(const char *filepath) {
+	FILE *fp = fopen(filepath, "w");
+	if (!fp) return -1;
+
+	boost::mutex::scoped_lock lck(trace_mtx);
+	unsigned long i, first, dropped(0);
+	int n(0);
+	bool sep(false);
+
+	fprintf(fp, "{\"traceEvents\":[\n");
+	for (std::vector<PVTRACERING>::iterator it = trace_rings.begin(); it != trace_rings.end(); ++it) {
+		pv_trace_ring &ring = **it;
+		if (ring.name.size()) {// 线程名称
+			fprintf(fp, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":",
+					sep ? ",\n" : "", ring.tid);
+			write_string(fp, ring.name.c_str());
+			fprintf(fp, "}}");
+			sep = true;
+		}
+		first = ring.count > RING_SIZE ? ring.count - RING_SIZE : 0;
+		dropped += first;
+		for (i = first; i < ring.count; ++i, ++n) {
+			PVTRACEEVENT &e = ring.events[i % RING_SIZE];
+			fprintf(fp, "%s{\"ph\":\"X\",\"name\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{",
+					sep ? ",\n" : "", e.name, ring.tid, e.ts, e.dur);
+			sep = true;
+			bool comma(false);
+			if (e.camid >= 0) {
+				fprintf(fp, "\"camid\":%d", e.camid);
+				comma = true;
+			}
+			if (e.fno >= 0) {
+				fprintf(fp, "%s\"fno\":%d", comma ? "," : "", e.fno);
+				comma = true;
+			}
+			if (e.detail[0]) {
+				fprintf(fp, "%s\"detail\":", comma ? "," : "");
+				write_string(fp, e.detail);
+			}
+			fprintf(fp, "}}");
+		}
+	}
+	fprintf(fp, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":%lu}}\n", dropped);
+	fclose(fp);
+	return n;
+}
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,99 @@
+/*
+ * @file APVTrace.h 类APVTrace的声明文件
+ * APVTrace -- 记录处理流程的时间线, 输出为Chrome/Perfetto trace-event JSON
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * 使用流程:
+ * (1) APVTrace::Enable(),  启用记录. 未启用时APVTraceScope仅检查一次标志
+ * (2) APVTraceScope,       在作用域内计时, 结束时记录一个完整事件(ph = "X")
+ * (3) APVTrace::Write(),   所有工作线程结束后, 将事件写入JSON文件
+ *
+ * @note
+ * - 每个线程拥有独立的环形缓冲区, 记录时无需加锁. 缓冲区满时覆盖最早的事件
+ * - 事件名称须为静态字符串; 附加说明被截断复制
+ */
+
+#ifndef APVTRACE_H_
+#define APVTRACE_H_
+
+#include <vector>
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+typedef struct pv_trace_event {// 完整事件
+	const char *name;	//< 事件名称, 静态字符串
+	double ts;			//< 起始时间, 量纲: 微秒
+	double dur;			//< 持续时间, 量纲: 微秒
+	int camid;			//< 相机编号. 负数表示无效
+	int fno;			//< 帧编号. 负数表示无效
+	char detail[48];	//< 附加说明, 如文件名
+}PVTRACEEVENT;
+
+class APVTrace {
+public:
+	enum {
+		RING_SIZE = 1 << 15	//< 每个线程环形缓冲区的事件数量
+	};
+
+	/*!
+	 * @brief 启用记录
+	 */
+	static void Enable();
+	/*!
+	 * @brief 是否已启用记录
+	 */
+	static bool IsEnabled() {
+		return enabled_;
+	}
+	/*!
+	 * @brief 当前时间, 量纲: 微秒. 以Enable()时刻为零点
+	 */
+	static double Now();
+	/*!
+	 * @brief 设置调用线程的名称, 显示于时间线
+	 */
+	static void SetThreadName(const char *name);
+	/*!
+	 * @brief 在调用线程的环形缓冲区中记录一个完整事件
+	 */
+	static void Record(const char *name, double ts, double dur, int camid, int fno, const char *detail = 0);
+	/*!
+	 * @brief 将所有线程记录的事件写入JSON文件. 应在工作线程结束后调用
+	 * @return
+	 * 写入的事件数量. 失败时为负数
+	 */
+	static int Write(const char *filepath);
+
+protected:
+	static bool enabled_;	//< 启用标志
+};
+
+/*
+ * @brief 在作用域内计时的事件
+ */
+class APVTraceScope {
+protected:
+	const char *name_;
+	int camid_, fno_;
+	const char *detail_;
+	double ts_;
+
+public:
+	APVTraceScope(const char *name, int camid = -1, int fno = -1, const char *detail = 0) {
+		name_   = APVTrace::IsEnabled() ? name : 0;
+		camid_  = camid;
+		fno_    = fno;
+		detail_ = detail;
+		ts_     = name_ ? APVTrace::Now() : 0.0;
+	}
+
+	~APVTraceScope() {
+		if (name_) APVTrace::Record(name_, ts_, APVTrace::Now() - ts_, camid_, fno_, detail_);
+	}
+};
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif /* APVTRACE_H_ */
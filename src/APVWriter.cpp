@@ -0,0 +1,73 @@
+/*
+ * @file APVWriter.cpp 类APVWriter的定义文件
+ * @version 0.1
+ * @date Oct 17, 2026
+ */
+#include <boost/bind/bind.hpp>
+#include <boost/make_shared.hpp>
+#include "APVWriter.h"
+#include "APVTrace.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+APVWriter::APVWriter(const PVExportFunc &func, int capacity)
+	: chan_("recognize->write", capacity) {
+	func_   = func;
+	stop_   = false;
+	pushed_ = 0;
+	done_   = 0;
+	nobj_   = 0;
+	thrd_   = boost::thread(boost::bind(&APVWriter::thread_write, this));
+}
+
+APVWriter::~APVWriter() {
+	Close();
+}
+
+int APVWriter::Push(int camid, PPVOBJVEC &objs) {
+	PPVBATCH batch = boost::make_shared<PVBATCH>();
+	int n = objs.size();
+
+	batch->camid = camid;
+	batch->objs.swap(objs);
+
+	if (stop_) {// 后台线程已结束
+		nobj_ += func_(batch->camid, batch->objs);
+		return n;
+	}
+	chan_.Push(batch);
+	++pushed_;
+	return n;
+}
+
+void APVWriter::Flush() {
+	for (int i = 0; done_.load(boost::memory_order_acquire) < pushed_; ++i)
+		pv_channel_backoff(i);
+}
+
+int APVWriter::Close() {
+	if (!stop_) {
+		stop_ = true;
+		chan_.Close();
+	}
+	if (thrd_.joinable()) thrd_.join();
+	return Exported();
+}
+
+int APVWriter::Exported() {
+	return nobj_;
+}
+
+void APVWriter::thread_write() {
+	PPVBATCH batch;
+
+	APVTrace::SetThreadName("writer");
+
+	while (chan_.Pop(batch)) {// 关闭前导出所有剩余批次
+		nobj_ += func_(batch->camid, batch->objs);
+		batch.reset();	// 释放目标
+		done_.fetch_add(1, boost::memory_order_release);
+	}
+}
+///////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,100 @@
+/*
+ * @file APVWriter.h 类APVWriter的声明文件
+ * APVWriter -- 异步输出识别目标. 由后台线程按提交次序导出批次
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * 使用流程:
+ * (1) APVWriter(), 指定导出函数及队列容量
+ * (2) Push(),      提交一个批次的目标. 队列已满时等待, 直至后台线程导出最早的批次
+ * (3) Close(),     等待队列中所有批次导出完成, 结束后台线程
+ *
+ * @note
+ * - Push()交换而非复制目标集合, 数据点由shared_ptr共享
+ * - 导出函数仅在后台线程中调用, 调用次序与提交次序相同
+ * - 批次经APVChannel无锁队列交付后台线程: 同一时刻仅允许一个线程调用Push()
+ */
+
+#ifndef APVWRITER_H_
+#define APVWRITER_H_
+
+#include <boost/function.hpp>
+#include <boost/atomic.hpp>
+#include <boost/thread/thread.hpp>
+#include "APVRec.h"
+#include "APVChannel.h"
+
+namespace AstroUtil {
+///////////////////////////////////////////////////////////////////////////////
+typedef struct pv_batch {// 待导出的一个批次
+	int camid;		//< 相机编号
+	PPVOBJVEC objs;	//< 识别目标
+}PVBATCH;
+typedef boost::shared_ptr<PVBATCH> PPVBATCH;
+
+/*!
+ * @brief 导出函数
+ * @param 1 相机编号
+ * @param 2 识别目标
+ * @return
+ * 导出目标的数量
+ */
+typedef boost::function<int (int, PPVOBJVEC&)> PVExportFunc;
+
+class APVWriter {
+public:
+	/*!
+	 * @param func     导出函数
+	 * @param capacity 队列容量, 即未导出批次的最大数量
+	 */
+	APVWriter(const PVExportFunc &func, int capacity = 8);
+	virtual ~APVWriter();
+
+protected:
+	PVExportFunc func_;		//< 导出函数
+	APVChannel<PPVBATCH> chan_;	//< 未导出批次
+	boost::thread thrd_;	//< 后台线程
+	bool stop_;				//< 停止标志. 仅由提交线程访问
+	unsigned long pushed_;	//< 已提交批次数量. 仅由提交线程访问
+	boost::atomic<unsigned long> done_;	//< 已导出批次数量
+	boost::atomic<int> nobj_;	//< 已导出目标数量
+
+public:
+	/*!
+	 * @brief 提交一个批次的目标. 提交后objs被清空
+	 * @return
+	 * 提交的目标数量
+	 */
+	int Push(int camid, PPVOBJVEC &objs);
+	/*!
+	 * @brief 等待已提交批次全部导出
+	 */
+	void Flush();
+	/*!
+	 * @brief 导出剩余批次并结束后台线程. 此后Push()在调用线程中直接导出
+	 * @return
+	 * 导出目标的总数量
+	 */
+	int Close();
+	/*!
+	 * @brief 已导出目标数量
+	 */
+	int Exported();
+	/*!
+	 * @brief 查看队列统计. 应在Close()之后调用
+	 */
+	const PVCHANSTAT &Stat() const {
+		return chan_.Stat();
+	}
+
+protected:
+	/*!
+	 * @brief 后台线程
+	 */
+	void thread_write();
+};
+///////////////////////////////////////////////////////////////////////////////
+}
+
+#endif /* APVWRITER_H_ */
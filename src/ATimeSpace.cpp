@@ -805,6 +805,91 @@ double ATimeSpace::Epoch(double mjd) {
 	return (2000.0 + (mjd - MJD2K) / 365.25);
 }
 
+/* Dates and Delta(AT)s */
+static constexpr struct ats_leap {
+	int iyear, month;
+	double delat;
+
+	constexpr int key() const {// 12 * 年 + 月, 随日期严格递增
+		return 12 * iyear + month;
+	}
+} leap_changes[] = {
+		{ 1960,  1,  1.4178180 },
+		{ 1961,  1,  1.4228180 },
+		{ 1961,  8,  1.3728180 },
+		{ 1962,  1,  1.8458580 },
+		{ 1963, 11,  1.9458580 },
+		{ 1964,  1,  3.2401300 },
+		{ 1964,  4,  3.3401300 },
+		{ 1964,  9,  3.4401300 },
+		{ 1965,  1,  3.5401300 },
+		{ 1965,  3,  3.6401300 },
+		{ 1965,  7,  3.7401300 },
+		{ 1965,  9,  3.8401300 },
+		{ 1966,  1,  4.3131700 },
+		{ 1968,  2,  4.2131700 },
+		{ 1972,  1, 10.0       },
+		{ 1972,  7, 11.0       },
+		{ 1973,  1, 12.0       },
+		{ 1974,  1, 13.0       },
+		{ 1975,  1, 14.0       },
+		{ 1976,  1, 15.0       },
+		{ 1977,  1, 16.0       },
+		{ 1978,  1, 17.0       },
+		{ 1979,  1, 18.0       },
+		{ 1980,  1, 19.0       },
+		{ 1981,  7, 20.0       },
+		{ 1982,  7, 21.0       },
+		{ 1983,  7, 22.0       },
+		{ 1985,  7, 23.0       },
+		{ 1988,  1, 24.0       },
+		{ 1990,  1, 25.0       },
+		{ 1991,  1, 26.0       },
+		{ 1992,  7, 27.0       },
+		{ 1993,  7, 28.0       },
+		{ 1994,  7, 29.0       },
+		{ 1996,  1, 30.0       },
+		{ 1997,  7, 31.0       },
+		{ 1999,  1, 32.0       },
+		{ 2006,  1, 33.0       },
+		{ 2009,  1, 34.0       },
+		{ 2012,  7, 35.0       },
+		{ 2015,  7, 36.0       },
+		{ 2017,  1, 37.0       }
+};
+
+/* Number of Delta(AT) changes */
+enum { NDAT = (int) (sizeof leap_changes / sizeof leap_changes[0]) };
+
+/*
+ * @brief 检查表项按日期严格递增, 二分查找依赖该次序
+ */
+static constexpr bool leap_sorted(int i) {
+	return i + 1 >= NDAT || (leap_changes[i].key() < leap_changes[i + 1].key() && leap_sorted(i + 1));
+}
+static_assert(leap_sorted(0), "leap second table must be sorted by date");
+
+/*
+ * @brief 查找不晚于m = 12 * 年 + 月的最后一个表项
+ * @return
+ * 表项序号. m早于首个表项时为-1
+ * @note
+ * 连续调用通常位于同一天, 因此缓存最近一次的月份与查找结果. 缓存为线程局部变量
+ */
+static int leap_index(int m) {
+	static thread_local int mlast(0), ilast(-1);
+	if (m == mlast) return ilast;
+
+	int lo(0), hi(NDAT), mid;
+	while (lo < hi) {// 二分查找: 首个晚于m的表项
+		mid = (lo + hi) / 2;
+		if (leap_changes[mid].key() <= m) lo = mid + 1;
+		else hi = mid;
+	}
+	mlast = m;
+	return (ilast = lo - 1);
+}
+
 double ATimeSpace::DeltaAT(int iy, int im, int id, double fd) {
 	const int IYV = 2017;	// 最后更新闰秒: 2017-01-01
 	/* Reference dates (MJD) and drift rates (s/day), pre leap seconds */
@@ -828,72 +913,15 @@ double ATimeSpace::DeltaAT(int iy, int im, int id, double fd) {
 	/* Number of Delta(AT) expressions before leap seconds were introduced */
 	enum { NERA1 = (int) (sizeof drift / sizeof (double) / 2) };
 
-	/* Dates and Delta(AT)s */
-	static const struct {
-		int iyear, month;
-		double delat;
-	} changes[] = {
-			{ 1960,  1,  1.4178180 },
-			{ 1961,  1,  1.4228180 },
-			{ 1961,  8,  1.3728180 },
-			{ 1962,  1,  1.8458580 },
-			{ 1963, 11,  1.9458580 },
-			{ 1964,  1,  3.2401300 },
-			{ 1964,  4,  3.3401300 },
-			{ 1964,  9,  3.4401300 },
-			{ 1965,  1,  3.5401300 },
-			{ 1965,  3,  3.6401300 },
-			{ 1965,  7,  3.7401300 },
-			{ 1965,  9,  3.8401300 },
-			{ 1966,  1,  4.3131700 },
-			{ 1968,  2,  4.2131700 },
-			{ 1972,  1, 10.0       },
-			{ 1972,  7, 11.0       },
-			{ 1973,  1, 12.0       },
-			{ 1974,  1, 13.0       },
-			{ 1975,  1, 14.0       },
-			{ 1976,  1, 15.0       },
-			{ 1977,  1, 16.0       },
-			{ 1978,  1, 17.0       },
-			{ 1979,  1, 18.0       },
-			{ 1980,  1, 19.0       },
-			{ 1981,  7, 20.0       },
-			{ 1982,  7, 21.0       },
-			{ 1983,  7, 22.0       },
-			{ 1985,  7, 23.0       },
-			{ 1988,  1, 24.0       },
-			{ 1990,  1, 25.0       },
-			{ 1991,  1, 26.0       },
-			{ 1992,  7, 27.0       },
-			{ 1993,  7, 28.0       },
-			{ 1994,  7, 29.0       },
-			{ 1996,  1, 30.0       },
-			{ 1997,  7, 31.0       },
-			{ 1999,  1, 32.0       },
-			{ 2006,  1, 33.0       },
-			{ 2009,  1, 34.0       },
-			{ 2012,  7, 35.0       },
-			{ 2015,  7, 36.0       },
-			{ 2017,  1, 37.0       }
-	   };
-
-	/* Number of Delta(AT) changes */
-	const int NDAT = sizeof changes / sizeof changes[0];
-
-	/* Miscellaneous local variables */
-	int i, m;
-	double da(0.0);
-
 	/* Combine year and month to form a date-ordered integer... */
-	m = 12 * iy + im;
-
+	int m = 12 * iy + im;
 	/* ...and use it to find the preceding table entry. */
-	for (i = NDAT-1; i >=0; i--) {
-		if (m >= (12 * changes[i].iyear + changes[i].month)) break;
-	}
+	int i = leap_index(m);
+	double da(0.0);
 
+	if (i < 0) return da;	// 早于1960年: 无定义
 	/* Get the Delta(AT). */
-	da = changes[i].delat;
+	da = leap_changes[i].delat;
 
 	/* If pre-1972, adjust for drift. */
 	if (i < NERA1) da += (ModifiedJulianDay(iy, im, id, fd) + fd - drift[i][0]) * drift[i][1];
@@ -1221,3 +1249,66 @@ int ATimeSpace::TimeOfSunAlt(double& sunrise, double& sunset, double alt) {
 
 	return 0;
 }
+
+///////////////////////////////////////////////////////////////////////////////
+ATimePoint::ATimePoint(int iy, int im, int id, double fd) {
+	mjd_ = ATimeSpace::ModifiedJulianDay(iy, im, id, fd);
+	dat_ = ATimeSpace::DeltaAT(iy, im, id, fd);
+}
+
+ATimePoint::ATimePoint(double mjd) {
+	int iy, im, id;
+	double fd;
+
+	mjd_ = mjd;
+	ATimeSpace::Mjd2Cal(mjd, iy, im, id, fd);
+	dat_ = ATimeSpace::DeltaAT(iy, im, id, fd);
+}
+
+double ATimePoint::JulianDay() const {
+	return mjd_ + MJD0;
+}
+
+double ATimePoint::TAI() const {
+	return mjd_ + dat_ / DAYSEC;
+}
+
+double ATimePoint::JulianCentury() const {
+	return ATimeSpace::JulianCentury(mjd_);
+}
+
+double ATimePoint::Epoch() const {
+	return ATimeSpace::Epoch(mjd_);
+}
+
+void ATimePoint::Calendar(int& iy, int& im, int& id, double& fd) const {
+	ATimeSpace::Mjd2Cal(mjd_, iy, im, id, fd);
+}
+
+double ATimePoint::GreenwichMeanSiderealTime() const {
+	return ATimeSpace::GreenwichMeanSiderealTime(mjd_);
+}
+
+double ATimePoint::GreenwichSiderealTime() const {
+	return ATimeSpace::GreenwichSiderealTime(mjd_);
+}
+
+double ATimePoint::LocalMeanSiderealTime(double lgt) const {
+	return ATimeSpace::LocalMeanSiderealTime(mjd_, lgt);
+}
+
+double ATimePoint::LocalSiderealTime(double lgt) const {
+	return ATimeSpace::LocalSiderealTime(mjd_, lgt);
+}
+
+double ATimePoint::MeanObliquity() const {
+	return ATimeSpace::MeanObliquity(JulianCentury());
+}
+
+double ATimePoint::TrueObliquity() const {
+	return ATimeSpace::TrueObliquity(JulianCentury());
+}
+
+void ATimePoint::Nutation(double& nl, double& no) const {
+	ATimeSpace::Nutation(JulianCentury(), nl, no);
+}
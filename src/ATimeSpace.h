@@ -21,6 +21,12 @@
  * @note
  * - 使用UTC代替UT1(世界时), 二者通过闰秒, 相差不超过0.9秒
  * @note
+ * 线程安全:
+ * - 静态函数(ModifiedJulianDay(iy, im, id, fd)、Mjd2Cal()、DeltaAT(iy, im, id, fd)等)不访问对象状态.
+ *   DeltaAT()缓存最近一次查找的月份与闰秒表项, 缓存为线程局部变量
+ * - ATimePoint为不可变时间点, 其成员函数均为const
+ * - SetUTC()等设置函数修改缓冲区, 同一ATimeSpace对象不能被多个线程共享
+ * @note
  * 历元转换补充说明:
  * 当输入输出数据对应历元都不是J2000时, 应
  * - 调用EqReTransfer(), 从输入历元转换到J2000
@@ -75,6 +81,11 @@ public:
 	 * @param t 历元
 	 */
 	void SetMJD(double mjd);
+
+public:
+	/*
+	 * 以下静态函数不访问对象状态, 可被多个线程并发调用
+	 */
 	/*!
 	 * @brief 计算修正儒略日
 	 * @param iy 年
@@ -84,21 +95,21 @@ public:
 	 * @return
 	 * 修正儒略日, 量纲: 天
 	 */
-	double ModifiedJulianDay(int iy, int im, int id, double fd);
+	static double ModifiedJulianDay(int iy, int im, int id, double fd);
 	/*!
 	 * @brief 相对J2000的儒略世纪
 	 * @param mjd 修正儒略日
 	 * @return
 	 * 儒略世纪
 	 */
-	double JulianCentury(double mjd);
+	static double JulianCentury(double mjd);
 	/*!
 	 * @brief 历元
 	 * @param mjd 修正儒略日
 	 * @return
 	 * 历元
 	 */
-	double Epoch(double mjd);
+	static double Epoch(double mjd);
 	/*!
 	 * @brief 计算闰秒: DAT=TAI-UTC
 	 * @param iy 年
@@ -108,7 +119,7 @@ public:
 	 * @return
 	 * 闰秒, 量纲: 秒
 	 */
-	double DeltaAT(int iy, int im, int id, double fd);
+	static double DeltaAT(int iy, int im, int id, double fd);
 	/*!
 	 * @brief 修正儒略日转换为格里高利历
 	 * @param mjd 修正儒略日
@@ -117,7 +128,7 @@ public:
 	 * @param id  天
 	 * @param fd  天的小数部分
 	 */
-	void Mjd2Cal(double mjd, int& iy, int& im, int& id, double& fd);
+	static void Mjd2Cal(double mjd, int& iy, int& im, int& id, double& fd);
 	/*!
 	 * @brief 儒略日转换为格里高利历
 	 * @param jd  儒略日
@@ -126,14 +137,14 @@ public:
 	 * @param id  天
 	 * @param fd  天的小数部分
 	 */
-	void Jd2Cal(double jd, int& iy, int& im, int& id, double& fd);
+	static void Jd2Cal(double jd, int& iy, int& im, int& id, double& fd);
 	/*!
 	 * @brief UTC对应的修正儒略日转换为TAI对应的修正儒略日
 	 * @param mjd 修正儒略日
 	 * @return
 	 * TAI对应的修正儒略日
 	 */
-	double UTC2TAI(double mjd);
+	static double UTC2TAI(double mjd);
 	/*!
 	 * @brief TAI对应的修正儒略日转换为UT1对应的修正儒略日
 	 * @param mjd 修正儒略日
@@ -141,7 +152,7 @@ public:
 	 * @return
 	 * UT1对应的修正儒略日
 	 */
-	double TAI2UT1(double mjd, double dta);
+	static double TAI2UT1(double mjd, double dta);
 	/*!
 	 * @brief UTC对应的修正儒略日转换为UT1对应的修正儒略日
 	 * @param mjd 修正儒略日
@@ -149,21 +160,21 @@ public:
 	 * @return
 	 * UT1对应的修正儒略日
 	 */
-	double UTC2UT1(double mjd, double dut);
+	static double UTC2UT1(double mjd, double dut);
 	/*!
 	 * @brief 查看与儒略日对应的格林尼治平恒星时
 	 * @param mjd 修正儒略日
 	 * @return
 	 * 平恒星时, 量纲: 弧度
 	 */
-	double GreenwichMeanSiderealTime(double mjd);
+	static double GreenwichMeanSiderealTime(double mjd);
 	/*!
 	 * @brief 查看与儒略日对应的格林尼治真恒星时
 	 * @param mjd 修正儒略日
 	 * @return
 	 * 真恒星时, 量纲: 弧度
 	 */
-	double GreenwichSiderealTime(double mjd);
+	static double GreenwichSiderealTime(double mjd);
 	/*!
 	 * @brief 查看与儒略日对应的本地平恒星时
 	 * @param mjd 修正儒略日
@@ -171,7 +182,7 @@ public:
 	 * @return
 	 * 平恒星时, 量纲: 弧度
 	 */
-	double LocalMeanSiderealTime(double mjd, double lgt);
+	static double LocalMeanSiderealTime(double mjd, double lgt);
 	/*!
 	 * @brief 查看与儒略日对应的本地真恒星时
 	 * @param mjd 修正儒略日
@@ -179,21 +190,21 @@ public:
 	 * @return
 	 * 平恒星时, 量纲: 弧度
 	 */
-	double LocalSiderealTime(double mjd, double lgt);
+	static double LocalSiderealTime(double mjd, double lgt);
 	/*!
 	 * @brief 计算与儒略世纪对应的平黄赤交角
 	 * @param t 相对J2000的儒略世纪
 	 * @return
 	 * 平黄赤交角, 量纲: 弧度
 	 */
-	double MeanObliquity(double t);
+	static double MeanObliquity(double t);
 	/*!
 	 * @brief 计算与儒略世纪对应的真黄赤交角
 	 * @param t 相对J2000的儒略世纪
 	 * @return
 	 * 真黄赤交角, 量纲: 弧度
 	 */
-	double TrueObliquity(double t);
+	static double TrueObliquity(double t);
 	/*!
 	 * @brief 计算与儒略世纪对应的黄经章动和交角章动
 	 * @param t  相对J2000的儒略世纪
@@ -202,21 +213,21 @@ public:
 	 * @return
 	 * 黄经章动, 量纲: 弧度
 	 */
-	void Nutation(double t, double& nl, double& no);
+	static void Nutation(double t, double& nl, double& no);
 	/*!
 	 * @brief 计算与儒略世纪对应的太阳平近点角
 	 * @param t 相对J2000的儒略世纪
 	 * @return
 	 * 平近点角, 量纲: 弧度
 	 */
-	double MeanAnomalySun(double t);
+	static double MeanAnomalySun(double t);
 	/*!
 	 * @brief 计算与儒略世纪对应的月亮平近点角
 	 * @param t 相对J2000的儒略世纪
 	 * @return
 	 * 平近点角, 量纲: 弧度
 	 */
-	double MeanAnomalyMoon(double t);
+	static double MeanAnomalyMoon(double t);
 	/*!
 	 * @brief 计算与儒略世纪对应的日月平角距
 	 * @param t 相对J2000的儒略世纪
@@ -225,7 +236,7 @@ public:
 	 * @note
 	 * 平角距: Mean Elongation of the Moon from the Sun
 	 */
-	double MeanElongationMoonSun(double t);
+	static double MeanElongationMoonSun(double t);
 	/*!
 	 * @brief 计算与儒略世纪对应的月亮升交点平黄经
 	 * @param t 相对J2000的儒略世纪
@@ -234,56 +245,56 @@ public:
 	 * @note
 	 * 月亮升交点平黄经: Longitude of the ascending node of the Moon's mean orbit
 	 */
-	double MeanLongAscNodeMoon(double t);
+	static double MeanLongAscNodeMoon(double t);
 	/*!
 	 * @brief 计算与儒略世纪对应的月亮相对升交点平黄经位移
 	 * @param t 相对J2000的儒略世纪
 	 * @return
 	 * 平黄经位移, 量纲: 弧度
 	 */
-	double RelLongMoon(double t);
+	static double RelLongMoon(double t);
 	/*!
 	 * @brief 计算与儒略世纪对应的太阳平黄经
 	 * @param t 相对J2000的儒略世纪
 	 * @return
 	 * 平黄经, 量纲: 弧度
 	 */
-	double MeanLongSun(double t);
+	static double MeanLongSun(double t);
 	/*!
 	 * @brief 计算与儒略世纪对应的太阳位置
 	 * @param t   相对J2000的儒略世纪
 	 * @param ra  赤经, 量纲: 弧度
 	 * @param dec 赤纬, 量纲: 弧度
 	 */
-	void SunPosition(double t, double& ra, double& dec);
+	static void SunPosition(double t, double& ra, double& dec);
 	/*!
 	 * @brief 计算与儒略世纪对应的地球偏心率
 	 * @param t 相对J2000的儒略世纪
 	 * @return
 	 * 偏心率
 	 */
-	double EccentricityEarth(double t);
+	static double EccentricityEarth(double t);
 	/*!
 	 * @brief 计算与儒略世纪对应的地球轨道近日点黄经
 	 * @param t 相对J2000的儒略世纪
 	 * @return
 	 * 黄经, 量纲: 弧度
 	 */
-	double PerihelionLongEarth(double t);
+	static double PerihelionLongEarth(double t);
 	/*!
 	 * @brief 计算与儒略世纪对应的太阳中心黄经偏差量
 	 * @param t 相对J2000的儒略世纪
 	 * @return
 	 * 太阳中心黄经偏差量
 	 */
-	double CenterSun(double t);
+	static double CenterSun(double t);
 	/*!
 	 * @brief 计算与儒略世对应的太阳真黄经
 	 * @param t 相对J2000的儒略世纪
 	 * @return
 	 * 太阳真黄经, 量纲: 弧度
 	 */
-	double TrueLongSun(double t);
+	static double TrueLongSun(double t);
 
 public:
 	/*!
@@ -689,6 +700,96 @@ private:
 	double	values_[ATS_END];	//< 数据缓冲区, 避免重复计算
 	bool	valid_[ATS_END];	//< 数据缓冲区有效性
 };
+
+/*!
+ * @class ATimePoint 不可变UTC时间点
+ * @note
+ * - 构造时计算修正儒略日与闰秒, 其它量在调用时计算, 不缓存
+ * - 所有成员函数为const, 可在多个线程间共享或按值传递
+ */
+class ATimePoint {
+public:
+	/*!
+	 * @brief 由UTC时间构造时间点
+	 * @param iy 年
+	 * @param im 月
+	 * @param id 天
+	 * @param fd 天的小数部分
+	 */
+	ATimePoint(int iy, int im, int id, double fd);
+	/*!
+	 * @brief 由UTC时间对应的修正儒略日构造时间点
+	 */
+	explicit ATimePoint(double mjd);
+
+protected:
+	double mjd_;	//< UTC对应的修正儒略日
+	double dat_;	//< DAT=TAI-UTC, 量纲: 秒
+
+public:
+	/*!
+	 * @brief 修正儒略日
+	 */
+	double ModifiedJulianDay() const {
+		return mjd_;
+	}
+	/*!
+	 * @brief 儒略日
+	 */
+	double JulianDay() const;
+	/*!
+	 * @brief 闰秒: DAT=TAI-UTC, 量纲: 秒
+	 */
+	double DeltaAT() const {
+		return dat_;
+	}
+	/*!
+	 * @brief 原子时对应的修正儒略日
+	 */
+	double TAI() const;
+	/*!
+	 * @brief 相对J2000的儒略世纪
+	 */
+	double JulianCentury() const;
+	/*!
+	 * @brief 历元
+	 */
+	double Epoch() const;
+	/*!
+	 * @brief 转换为格里高利历
+	 */
+	void Calendar(int& iy, int& im, int& id, double& fd) const;
+	/*!
+	 * @brief 格林尼治平恒星时, 量纲: 弧度
+	 */
+	double GreenwichMeanSiderealTime() const;
+	/*!
+	 * @brief 格林尼治真恒星时, 量纲: 弧度
+	 */
+	double GreenwichSiderealTime() const;
+	/*!
+	 * @brief 本地平恒星时, 量纲: 弧度
+	 * @param lgt 地理经度, 量纲: 弧度. 东经为正
+	 */
+	double LocalMeanSiderealTime(double lgt) const;
+	/*!
+	 * @brief 本地真恒星时, 量纲: 弧度
+	 * @param lgt 地理经度, 量纲: 弧度. 东经为正
+	 */
+	double LocalSiderealTime(double lgt) const;
+	/*!
+	 * @brief 平黄赤交角, 量纲: 弧度
+	 */
+	double MeanObliquity() const;
+	/*!
+	 * @brief 真黄赤交角, 量纲: 弧度
+	 */
+	double TrueObliquity() const;
+	/*!
+	 * @brief 黄经章动和交角章动, 量纲: 弧度
+	 */
+	void Nutation(double& nl, double& no) const;
+};
 ///////////////////////////////////////////////////////////////////////////////
 }
 
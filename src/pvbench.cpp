@@ -0,0 +1,867 @@
+/*
+ * @file pvbench.cpp 性能测试
+ * @version 0.1
+ * @date Oct 17, 2026
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <boost/make_shared.hpp>
+#include "APVRec.h"
+#include "APVBinary.h"
+#include "APVChunkParser.h"
+#include "APVDemux.h"
+#include "APVFormat.h"
+#include "APVParser.h"
+#include "APVReader.h"
+#include "ATimeSpace.h"
+#include "pvbench.h"
+
+using std::string;
+using namespace AstroUtil;
+
+/*
+ * @brief 单调时钟, 量纲: 秒
+ */
+static double bench_now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1E-9;
+}
+
+/*
+ * @brief 读取文本文件, 按行拆分. 跳过第一行注释
+ */
+static bool bench_load(const char *filepath, string &text, std::vector<size_t> &lines) {
+	FILE *fp = fopen(filepath, "rb");
+	if (!fp) {
+		printf("failed to open file: %s\n", filepath);
+		return false;
+	}
+	fseek(fp, 0, SEEK_END);
+	text.resize(ftell(fp));
+	fseek(fp, 0, SEEK_SET);
+	if (text.size()) text.resize(fread(&text[0], 1, text.size(), fp));
+	fclose(fp);
+
+	size_t pos = text.find('\n');
+	while (pos != string::npos && pos + 1 < text.size()) {
+		lines.push_back(pos + 1);
+		if ((pos = text.find('\n', pos + 1)) != string::npos) text[pos] = 0;
+	}
+	return true;
+}
+
+/*
+ * @brief 原解析算法: sscanf()
+ */
+static void legacy_resolve(const char* line, PVPT &pt, int &camid) {
+	int iy, im, id, hh, mm, ss, mics;
+	double errmag;
+
+	sscanf(line, "%d-%d-%d %d:%d:%d, %d, %lf, %lf, %lf, %lf, %lf, %lf, %d, %d",
+			&iy, &im, &id, &hh, &mm, &ss, &pt.fno,
+			&pt.x, &pt.y, &pt.ra, &pt.dc,
+			&pt.mag, &errmag, &mics, &camid);
+	pt.mjd = ATimeSpace::ModifiedJulianDay(iy, im, id,
+			(hh + (mm + (ss + mics * 1E-6 + 5.0) / 60.0) / 60.0) / 24.0);
+}
+
+/*
+ * @brief 两个数据点是否逐位一致
+ */
+static bool same_point(const PVPT &a, const PVPT &b) {
+	return a.fno == b.fno && a.mjd == b.mjd && a.x == b.x && a.y == b.y
+			&& a.ra == b.ra && a.dc == b.dc && a.mag == b.mag;
+}
+
+/*
+ * @brief 原始数据解析吞吐量
+ */
+static int bench_parse(int argc, char **argv) {
+	if (argc < 1) {
+		printf("Usage: pvrec bench parse <RAW file> [repeat]\n");
+		return -1;
+	}
+	int repeat = argc > 1 ? atoi(argv[1]) : 5;
+	string text;
+	std::vector<size_t> lines;
+	if (!bench_load(argv[0], text, lines)) return -2;
+
+	int n = lines.size(), i, k, camid(0), nbad(0), ndiff(0);
+	double mb = text.size() / 1048576.0, t0, t1, t2;
+	std::vector<PVPT> pts1(n), pts2(n);
+	APVParser parser;
+	const char *base = text.c_str();
+
+	if (repeat < 1) repeat = 1;
+	t0 = bench_now();
+	for (k = 0; k < repeat; ++k) {
+		for (i = 0; i < n; ++i) legacy_resolve(base + lines[i], pts1[i], camid);
+	}
+	t1 = bench_now();
+	for (k = 0; k < repeat; ++k) {
+		for (i = 0; i < n; ++i) {
+			if (parser.Resolve(base + lines[i], pts2[i], camid) < 0) ++nbad;
+		}
+	}
+	t2 = bench_now();
+
+	for (i = 0; i < n; ++i) {// 两种算法的解析结果应逐位一致
+		if (!same_point(pts1[i], pts2[i])) ++ndiff;
+	}
+	printf("lines: %d, size: %.1f MB, repeat: %d\n", n, mb, repeat);
+	printf("sscanf    : %10.0f lines/s %8.1f MB/s\n", n * repeat / (t1 - t0), mb * repeat / (t1 - t0));
+	printf("APVParser : %10.0f lines/s %8.1f MB/s\n", n * repeat / (t2 - t1), mb * repeat / (t2 - t1));
+	printf("speedup   : %.2f\n", (t1 - t0) / (t2 - t1));
+	printf("malformed : %d, mismatched: %d\n", nbad / repeat, ndiff);
+	return ndiff ? -3 : 0;
+}
+
+/*
+ * @brief 原输出算法: Mjd2Cal()+Days2HMS()+fprintf(). 以snprintf()写入内存, 不计磁盘开销
+ */
+static void legacy_format(const PVOBJ &obj, string &text) {
+	char line[1024];
+	int iy, im, id, hh, mm, n;
+	double ss, fd;
+
+	for (PPVPTVEC::const_iterator i = obj.pts.begin(); i != obj.pts.end(); ++i) {
+		const PVPT &pt = **i;
+		ATimeSpace::Mjd2Cal(pt.mjd, iy, im, id, fd);
+		fd *= 24.0;
+		hh = (int) fd;
+		fd = (fd - hh) * 60.0;
+		mm = (int) fd;
+		ss = (fd - mm) * 60.0;
+		n = snprintf(line, sizeof(line), "%d %02d %02d %02d %02d %06.3f %4d %9.5f %9.5f ",
+				iy, im, id, hh, mm, ss, pt.fno, pt.ra, pt.dc);
+		if (pt.mag > 20.0) n += snprintf(line + n, sizeof(line) - n, "99.99\r\n");
+		else n += snprintf(line + n, sizeof(line) - n, "%5.2f\r\n", pt.mag);
+		text.append(line, n);
+	}
+}
+
+/*
+ * @brief 目标输出格式化吞吐量
+ */
+static int bench_format(int argc, char **argv) {
+	int nrow = argc > 0 ? atoi(argv[0]) : 1000000;
+	int nper = 20, nobj, i, j;
+	if (nrow < nper) nrow = nper;
+	nobj = nrow / nper;
+	nrow = nobj * nper;
+
+	// 生成目标: 时间跨越数日, 坐标及星等覆盖正负、边界及99.99标记
+	std::vector<PPVOBJ> objs(nobj);
+	srand(1);
+	for (i = 0; i < nobj; ++i) {
+		objs[i] = boost::make_shared<PVOBJ>();
+		double mjd = 58500.0 + 5.0 * rand() / RAND_MAX;
+		double ra  = 360.0 * rand() / RAND_MAX, dc = 180.0 * rand() / RAND_MAX - 90.0;
+		for (j = 0; j < nper; ++j) {
+			PPVPT pt = boost::make_shared<PVPT>();
+			pt->fno = i * 3 + j;
+			pt->mjd = mjd + j * 10.0 / 86400.0;
+			pt->ra  = ra + j * 1E-4;
+			pt->dc  = dc - j * 1E-4;
+			pt->mag = 10.0 + 12.0 * rand() / RAND_MAX;
+			objs[i]->pts.push_back(pt);
+		}
+	}
+
+	string text1;
+	APVFormat text2;
+	double t0, t1, t2;
+	size_t nbyte;
+
+	text1.reserve(size_t(nrow) * 64);
+	t0 = bench_now();
+	for (i = 0; i < nobj; ++i) legacy_format(*objs[i], text1);
+	t1 = bench_now();
+	for (i = 0; i < nobj; ++i) text2.Object(*objs[i]);
+	t2 = bench_now();
+
+	nbyte = text1.size();
+	bool same = nbyte == text2.Size() && memcmp(text1.data(), text2.Data(), nbyte) == 0;
+	printf("rows: %d, size: %.1f MB\n", nrow, nbyte / 1048576.0);
+	printf("snprintf  : %10.0f rows/s %8.1f MB/s\n", nrow / (t1 - t0), nbyte / 1048576.0 / (t1 - t0));
+	printf("APVFormat : %10.0f rows/s %8.1f MB/s\n", nrow / (t2 - t1), nbyte / 1048576.0 / (t2 - t1));
+	printf("speedup   : %.2f\n", (t1 - t0) / (t2 - t1));
+	printf("identical : %s\n", same ? "yes" : "NO");
+	return same ? 0 : -3;
+}
+
+/*---------------------------------------------------------------------------*/
+/* 合成数据 */
+/*
+ * @brief 合成数据参数
+ */
+struct gen_param {
+	int nstar;		//< 每台相机的恒星数量
+	int nmover;		//< 每台相机的运动目标数量
+	int ncam;		//< 相机数量
+	int nframe;		//< 帧数
+	double speed;	//< 运动目标最大速度, 量纲: 像素/帧
+	double noise;	//< 位置噪声标准差, 量纲: 像素
+	double dropout;	//< 运动目标单帧丢失概率
+	double cadence;	//< 帧间隔, 量纲: 秒
+	unsigned seed;	//< 随机数种子
+	int window;		//< 建立候选体的帧窗口. 2: 相邻两帧; 3: 三帧确认
+	int dupframe;	//< 时标与前一帧相同的帧编号. 0: 无
+
+public:
+	gen_param() {
+		nstar   = 300;
+		nmover  = 30;
+		ncam    = 2;
+		nframe  = 80;
+		speed   = 20.0;
+		noise   = 0.1;
+		dropout = 0.1;
+		cadence = 10.0;
+		seed    = 1;
+		window  = 2;
+		dupframe = 0;
+	}
+};
+
+/*
+ * @brief 与平台无关的伪随机数: xorshift64*
+ */
+struct gen_random {
+	unsigned long long state;
+
+public:
+	gen_random(unsigned seed) {
+		state = 0x9E3779B97F4A7C15ULL ^ seed;
+		if (!state) state = 1;
+	}
+
+	double uniform(double lo = 0.0, double hi = 1.0) {// [lo, hi)
+		state ^= state >> 12;
+		state ^= state << 25;
+		state ^= state >> 27;
+		return lo + (hi - lo) * ((state * 0x2545F4914F6CDD1DULL) >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	double gauss(double sigma) {// Box-Muller
+		double u = uniform(), v = uniform();
+		return sigma * sqrt(-2.0 * log(1.0 - u)) * cos(A2PI * v);
+	}
+};
+
+/*
+ * @brief 生成文本格式原始数据: 首行为注释, 其后每行一个数据点
+ * @note
+ * 靶面4096x4096像素. 帧时间始于2019-02-17 23:50:00, 跨越午夜.
+ * dupframe指定的帧沿用前一帧时标, 其余帧及随机数序列不变
+ */
+static void generate(const gen_param &param, string &text) {
+	struct star {
+		double x, y, vx, vy, mag;
+	};
+	const double width = 4096.0;
+	const int mjd0 = 58531, sec0 = (23 * 60 + 50) * 60;	// 2019-02-17 23:50:00
+	gen_random rnd(param.seed);
+	std::vector<star> stars(param.nstar + param.nmover);
+	std::vector<int> order;
+	char line[200];
+	int iy, im, id, hh, mm, ss, mics, cam, f, i, n, sec, secprev(0), micsprev(0);
+	double fd, x, y;
+
+	text = "# UTC, fno, X, Y, ra, dec, mag, mag_err, mics, camid\n";
+	for (cam = 1; cam <= param.ncam; ++cam) {
+		for (i = 0; i < int(stars.size()); ++i) {
+			star &s = stars[i];
+			s.x = rnd.uniform(0.0, width);
+			s.y = rnd.uniform(0.0, width);
+			s.vx = s.vy = 0.0;
+			s.mag = rnd.uniform(10.0, 19.0);
+			if (i >= param.nstar) {// 运动目标: 速度在[speed/4, speed)之间, 方向随机
+				double v = rnd.uniform(0.25, 1.0) * param.speed, a = rnd.uniform(0.0, A2PI);
+				s.x   = rnd.uniform(0.0, width) - v * cos(a) * param.nframe * 0.5;
+				s.y   = rnd.uniform(0.0, width) - v * sin(a) * param.nframe * 0.5;
+				s.vx  = v * cos(a);
+				s.vy  = v * sin(a);
+				s.mag = rnd.uniform(9.0, 21.0);
+			}
+		}
+		for (f = 0; f < param.nframe; ++f) {
+			sec  = sec0 + int(f * param.cadence);
+			mics = int(rnd.uniform(0.0, 1E6));
+			if (f > 0 && f + 1 == param.dupframe) {
+				sec  = secprev;
+				mics = micsprev;
+			}
+			secprev  = sec;
+			micsprev = mics;
+			ATimeSpace::Mjd2Cal(mjd0 + sec / 86400, iy, im, id, fd);
+			hh = sec % 86400 / 3600;
+			mm = sec % 3600 / 60;
+			ss = sec % 60;
+
+			order.clear();
+			for (i = 0; i < int(stars.size()); ++i) {
+				if (i >= param.nstar && rnd.uniform() < param.dropout) continue;
+				order.push_back(i);
+			}
+			for (i = int(order.size()) - 1; i > 0; --i) {// 打乱次序
+				int j = int(rnd.uniform(0.0, i + 1));
+				std::swap(order[i], order[j]);
+			}
+			for (std::vector<int>::iterator it = order.begin(); it != order.end(); ++it) {
+				star &s = stars[*it];
+				x = s.x + s.vx * f + rnd.gauss(param.noise);
+				y = s.y + s.vy * f + rnd.gauss(param.noise);
+				n = snprintf(line, sizeof(line),
+						"%04d-%02d-%02d %02d:%02d:%02d, %d, %.3f, %.3f, %.5f, %.5f, %.3f, %.3f, %d, %d\n",
+						iy, im, id, hh, mm, ss, f + 1, x, y, x / 100.0, y / 100.0 - 5.0,
+						s.mag, 0.05, mics, cam);
+				text.append(line, n);
+			}
+		}
+	}
+}
+
+/*
+ * @brief 解析合成数据参数
+ * @return
+ * 未识别参数的序号. 全部识别时为argc
+ */
+static int gen_options(int argc, char **argv, gen_param &param) {
+	int i;
+	for (i = 0; i + 1 < argc && argv[i][0] == '-'; i += 2) {
+		const char *val = argv[i + 1];
+		switch (argv[i][1]) {
+		case 's': param.nstar   = atoi(val); break;
+		case 'm': param.nmover  = atoi(val); break;
+		case 'c': param.ncam    = atoi(val); break;
+		case 'f': param.nframe  = atoi(val); break;
+		case 'v': param.speed   = atof(val); break;
+		case 'n': param.noise   = atof(val); break;
+		case 'd': param.dropout = atof(val); break;
+		case 't': param.cadence = atof(val); break;
+		case 'r': param.seed    = atoi(val); break;
+		case 'w': param.window  = atoi(val); break;
+		case 'u': param.dupframe = atoi(val); break;
+		default: return i;
+		}
+	}
+	return i;
+}
+
+static void gen_usage() {
+	printf("options: [-s stars] [-m movers] [-c cameras] [-f frames] [-v speed]\n");
+	printf("         [-n noise] [-d dropout] [-t cadence] [-r seed] [-w 2|3] [-u frame]\n");
+}
+
+/*
+ * @brief 生成合成数据文件
+ */
+static int bench_gen(int argc, char **argv) {
+	gen_param param;
+	string text;
+	if (argc < 1 || gen_options(argc - 1, argv + 1, param) != argc - 1) {
+		printf("Usage: pvrec bench gen <RAW file> [options]\n");
+		gen_usage();
+		return -1;
+	}
+	generate(param, text);
+	FILE *fp = fopen(argv[0], "wb");
+	if (!fp) {
+		printf("failed to create file: %s\n", argv[0]);
+		return -2;
+	}
+	fwrite(text.data(), 1, text.size(), fp);
+	fclose(fp);
+	printf("%d cameras x %d frames, %d stars and %d movers per camera, %.1f MB\n",
+			param.ncam, param.nframe, param.nstar, param.nmover, text.size() / 1048576.0);
+	return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/* 分阶段吞吐量 */
+#ifdef PVREC_PROFILE
+#define PV_BENCH_PROFILE(...)	__VA_ARGS__
+#else
+#define PV_BENCH_PROFILE(...)	do {} while (0)
+#endif
+
+/*
+ * @brief 计时阶段: 解析、识别、输出. 定义PVREC_PROFILE编译时,
+ * 识别阶段另按APVRec的性能分析数据细分为create/append/recheck/complete
+ */
+struct suite_stage {
+	const char *name;	//< 阶段名称
+	double elapse;		//< 累计耗时, 量纲: 秒
+};
+
+/*
+ * @brief 对一组合成数据执行完整流程, 输出各阶段吞吐量
+ * @param table  是否以表格行输出
+ * @param header 是否输出表头
+ * @note
+ * 识别阶段调用APVRec::AddPoint()/EndSequence(), 与pvrec的执行路径相同
+ */
+static void run_suite(const gen_param &param, bool table, bool header) {
+	string text;
+	generate(param, text);
+
+	// 解析
+	APVParser parser;
+	std::vector<std::vector<PVPT> > seqs;
+	std::vector<int> camids;
+	const char *line = strchr(text.c_str(), '\n') + 1, *end, *last = text.c_str() + text.size();
+	int camid, oldid(-1), npt(0), nfrm(0), nobj(0);
+	PVPT pt;
+	double t0, tparse, trec(0.0), tout(0.0);
+
+	t0 = bench_now();
+	for (; line < last; line = end + 1) {
+		if (!(end = (const char*) memchr(line, '\n', last - line))) end = last;
+		if (parser.Resolve(line, end, pt, camid) != APVParser::PARSE_OK) continue;
+		if (camid != oldid) {
+			seqs.push_back(std::vector<PVPT>());
+			camids.push_back(oldid = camid);
+		}
+		seqs.back().push_back(pt);
+	}
+	tparse = bench_now() - t0;
+
+	// 识别
+	APVRec pvrec;
+	APVFormat format;
+	param_pv pvparam;
+	PVPROFILE prof;
+	pvparam.triplet = param.window == 3;
+	pvrec.SetParam(pvparam);
+	for (size_t i = 0; i < seqs.size(); ++i) {
+		std::vector<PVPT> &pts = seqs[i];
+		for (std::vector<PVPT>::iterator it = pts.begin(); it != pts.end(); ++it) {
+			if (it == pts.begin() || it->fno != (it - 1)->fno) ++nfrm;
+		}
+		t0 = bench_now();
+		pvrec.NewSequence(camids[i]);
+		for (std::vector<PVPT>::iterator it = pts.begin(); it != pts.end(); ++it) pvrec.AddPoint(*it);
+		pvrec.EndSequence();
+		trec += bench_now() - t0;
+		prof += pvrec.GetProfile();
+		npt += pts.size();
+
+		// 输出: 格式化至内存, 不计磁盘开销
+		PPVOBJVEC &objs = pvrec.GetObject(camid);
+		t0 = bench_now();
+		for (PPVOBJVEC::iterator it = objs.begin(); it != objs.end(); ++it) {
+			format.Clear();
+			format.Object(**it);
+		}
+		tout += bench_now() - t0;
+		nobj += objs.size();
+	}
+
+	std::vector<suite_stage> stages;
+	suite_stage stage = {"parse", tparse};
+	stages.push_back(stage);
+	stage.name = "recognize", stage.elapse = trec;
+	stages.push_back(stage);
+#ifdef PVREC_PROFILE
+	for (int i = PVSTAGE_CREATE; i < PVSTAGE_MAX; ++i) {
+		stage.name = PVPROFILE::StageName(i), stage.elapse = prof.elapse[i];
+		stages.push_back(stage);
+	}
+#endif
+	stage.name = "output", stage.elapse = tout;
+	stages.push_back(stage);
+	int nstage = stages.size();
+
+	if (!table) {// 单组数据: 各阶段耗时及吞吐量
+		printf("cameras: %d, frames: %d, points: %d, objects: %d\n", param.ncam, nfrm, npt, nobj);
+#ifdef PVREC_PROFILE
+		printf("candidates: created %ld, peak %d\n", prof.created, prof.cansmax);
+#endif
+		printf("%-9s %10s %14s %12s\n", "stage", "time(ms)", "points/s", "frames/s");
+		for (int i = 0; i < nstage; ++i) {
+			double t = stages[i].elapse > 1E-9 ? stages[i].elapse : 1E-9;
+			printf("%-9s %10.2f %14.0f %12.0f\n", stages[i].name, stages[i].elapse * 1000.0, npt / t, nfrm / t);
+		}
+		return;
+	}
+	// 扫描密度: 每组数据一行, 各阶段吞吐量量纲为points/s; frames/s = points/s / (points/frame).
+	// cans: 候选体集合的最大规模, 仅定义PVREC_PROFILE时输出
+	if (header) {
+		printf("%7s %9s %6s", "stars", "pts/frm", "objs");
+		PV_BENCH_PROFILE(printf(" %7s", "cans"));
+		for (int i = 0; i < nstage; ++i) printf(" %11s", stages[i].name);
+		printf("\n");
+	}
+	printf("%7d %9.0f %6d", param.nstar, double(npt) / nfrm, nobj);
+	PV_BENCH_PROFILE(printf(" %7d", prof.cansmax));
+	for (int i = 0; i < nstage; ++i) printf(" %11.0f", npt / (stages[i].elapse > 1E-9 ? stages[i].elapse : 1E-9));
+	printf("\n");
+}
+
+/*
+ * @brief 分阶段吞吐量
+ */
+static int bench_suite(int argc, char **argv) {
+	gen_param param;
+	if (gen_options(argc, argv, param) != argc) {
+		printf("Usage: pvrec bench suite [options]\n");
+		gen_usage();
+		return -1;
+	}
+	run_suite(param, false, false);
+	return 0;
+}
+
+/*
+ * @brief 扫描数据密度: 恒星数量依次为-s参数的1/4, 1/2, 1, 2, 4倍
+ */
+static int bench_sweep(int argc, char **argv) {
+	gen_param param;
+	if (gen_options(argc, argv, param) != argc) {
+		printf("Usage: pvrec bench sweep [options]\n");
+		gen_usage();
+		return -1;
+	}
+	int nstar = param.nstar;
+	for (int i = 0; i < 5; ++i) {
+		param.nstar = nstar * (1 << i) / 4;
+		run_suite(param, true, i == 0);
+	}
+	return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/* 一致性检查 */
+typedef std::vector<std::pair<int, PVPT> > bench_points;	//< 相机编号及数据点, 按文件次序
+
+/*
+ * @brief 两组数据点中不一致的数量
+ */
+static int diff_points(const bench_points &a, const bench_points &b) {
+	int n = abs(int(a.size()) - int(b.size()));
+	for (size_t i = 0; i < a.size() && i < b.size(); ++i) {
+		if (a[i].first != b[i].first || !same_point(a[i].second, b[i].second)) ++n;
+	}
+	return n;
+}
+
+/*
+ * @brief 参照路径: APVReader逐行读取, APVParser解析. 同时与sscanf()比对
+ * @param nlegacy 与sscanf()解析结果不一致的行数
+ */
+static bool verify_load(const char *filepath, bench_points &pts, int &nlegacy) {
+	APVReader reader;
+	APVParser parser;
+	const char *line, *end;
+	string buff;
+	int camid, camid1;
+	PVPT pt, pt1;
+
+	if (!reader.Open(filepath)) return false;
+	nlegacy = 0;
+	reader.NextLine(line, end); // 空读一行
+	while (reader.NextLine(line, end)) {
+		if (parser.Resolve(line, end, pt, camid) != APVParser::PARSE_OK) continue;
+		pts.push_back(std::make_pair(camid, pt));
+		buff.assign(line, end);
+		legacy_resolve(buff.c_str(), pt1, camid1);
+		if (camid1 != camid || !same_point(pt, pt1)) ++nlegacy;
+	}
+	return true;
+}
+
+/*
+ * @brief 并行解析路径: APVChunkParser
+ */
+static bool verify_chunks(const char *filepath, int nthread, size_t chunksize, bench_points &pts) {
+	APVChunkParser chunker(nthread, chunksize);
+	const PVCHUNK *chunk;
+
+	if (!chunker.Open(filepath)) return false;
+	while ((chunk = chunker.Next())) {
+		for (size_t i = 0; i < chunk->pts.size(); ++i)
+			pts.push_back(std::make_pair(chunk->cams[i], chunk->pts[i]));
+	}
+	return true;
+}
+
+/*
+ * @brief 二进制路径: 转换为二进制数据点文件后加载
+ */
+static bool verify_binary(const char *pathRaw, const char *pathBin, bench_points &pts) {
+	APVBinary bin;
+	const PVBINREC *rec, *recend;
+	PVPT pt;
+
+	if (APVBinary::Convert(pathRaw, pathBin) < 0 || !bin.Open(pathBin)) return false;
+	for (int i = 0, n = bin.SequenceCount(); i < n; ++i) {
+		const PVBINSEQ &seq = bin.Sequence(i);
+		for (rec = bin.Records(seq.firstrec), recend = rec + seq.nrec; rec != recend; ++rec) {
+			APVBinary::ToPoint(*rec, pt);
+			pts.push_back(std::make_pair(seq.camid, pt));
+		}
+	}
+	return true;
+}
+
+/*
+ * @brief 识别路径: APVDemux, 按批次结束次序将目标格式化为文本
+ * @param objs 识别目标, 按输出次序
+ */
+static void verify_recognize(const bench_points &pts, int nthread, const param_pv &param,
+		string &text, std::vector<PPVOBJ> &objs) {
+	APVDemux demux(nthread, param);
+	APVFormat format;
+	PPVSEQ seq;
+	char head[32];
+
+	for (bench_points::const_iterator it = pts.begin(); it != pts.end(); ++it)
+		demux.AddPoint(it->first, it->second);
+	demux.End();
+	while ((seq = demux.Next(true)).use_count()) {
+		text.append(head, snprintf(head, sizeof(head), "# camera %d\n", seq->camid));
+		for (PPVOBJVEC::iterator it = seq->objs.begin(); it != seq->objs.end(); ++it) {
+			format.Clear();
+			format.Object(**it);
+			text.append(format.Data(), format.Size());
+			objs.push_back(*it);
+		}
+	}
+}
+
+/*
+ * @brief 原关联算法: 候选体与数据点逐一比对, 不使用网格索引.
+ * 仅替代create_candidates()与append_candidates(), 适用于缺省参数(无三帧确认, 无去重)
+ */
+class legacy_rec : public APVRec {
+protected:
+	void create_candidates() {
+		if (!(frmprev_.unique() && frmlast_.unique())) return;
+
+		PVIDXVEC &pts1 = frmprev_->pts;
+		PVIDXVEC &pts2 = frmlast_->pts;
+		const double *x = store_.X();
+		const double *y = store_.Y();
+		double stepmin = param_.stepmin;
+		double stepmax = param_.stepmax;
+		double dx, dy;
+		// 由相邻帧未关联数据构建候选体
+		for (PVIDXVEC::iterator it1 = pts1.begin(); it1 != pts1.end(); ++it1) {
+			for (PVIDXVEC::iterator it2 = pts2.begin(); it2 != pts2.end(); ++it2) {
+				dx = fabs(x[*it2] - x[*it1]);
+				dy = fabs(y[*it2] - y[*it1]);
+
+				if (stepmin <= dx && dx <= stepmax && stepmin <= dy && dy <= stepmax) {
+					PPVCAN can = boost::make_shared<PVCAN>(&store_);
+					can->add_point(*it1);
+					can->add_point(*it2);
+					cans_.push_back(can);
+				}
+			}
+		}
+	}
+
+	void append_candidates() {
+		if (!cans_.size()) return; // 无候选体立即返回
+
+		double stepmin = param_.stepmin;
+		double stepmax = param_.stepmax;
+		double dxy  = param_.dxymax;
+		double mjd = frmlast_->mjd;
+		const double *xs = store_.X();
+		const double *ys = store_.Y();
+		double x1, y1, x2, y2, dx1, dy1, dx2, dy2;
+		PVIDXVEC &pts = frmlast_->pts;
+		PPVCAN can;
+		int pt;
+
+		// 1. 尝试将帧数据追加至候选体. 候选体均含两个以上数据点, 可预测位置
+		for (PPVCANVEC::iterator it = cans_.begin(); it != cans_.end(); ++it) {
+			can = *it;
+			// 候选体最后一个点的坐标
+			pt = can->last_point();
+			x1 = xs[pt];
+			y1 = ys[pt];
+			for (PVIDXVEC::iterator i = pts.begin(); i != pts.end(); ++i) {// 与当前帧数据交叉比对
+				dx1 = fabs(x1 - xs[*i]);
+				dy1 = fabs(y1 - ys[*i]);
+				if (stepmin <= dx1 && dx1 <= stepmax && stepmin <= dy1 && dy1 <= stepmax
+						&& can->xy_expect(mjd, x2, y2)) {// 预测位置与测量位置偏差未超出阈值
+					dx2 = fabs(x2 - xs[*i]);
+					dy2 = fabs(y2 - ys[*i]);
+					if (dx2 <= dxy && dy2 <= dxy) can->add_point(*i);
+				}
+			}
+		}
+		// 2. 将确定帧数据加入候选体
+		for (PPVCANVEC::iterator it = cans_.begin(); it != cans_.end(); ++it) (*it)->update();
+		// 3. 剔除已加入候选体的数据点
+		int n(0);
+		for (PVIDXVEC::iterator it = pts.begin(); it != pts.end(); ++it) {
+			if (!store_.related(*it)) pts[n++] = *it;
+		}
+		pts.resize(n);
+		if (!pts.size()) frmlast_.reset();
+	}
+};
+
+/*
+ * @brief 识别路径: APVRec, 相机编号变化时开始新批次
+ */
+static void verify_sequences(APVRec &rec, const bench_points &pts, param_pv param, string &text) {
+	APVFormat format;
+	char head[32];
+	int camid(-1);
+
+	rec.SetParam(param);
+	for (bench_points::const_iterator it = pts.begin(); ; ++it) {
+		if (it == pts.end() || it->first != camid) {
+			if (camid != -1) {
+				rec.EndSequence();
+				PPVOBJVEC &objs = rec.GetObject(camid);
+				text.append(head, snprintf(head, sizeof(head), "# camera %d\n", camid));
+				for (PPVOBJVEC::iterator obj = objs.begin(); obj != objs.end(); ++obj) {
+					format.Clear();
+					format.Object(**obj);
+					text.append(format.Data(), format.Size());
+				}
+			}
+			if (it == pts.end()) break;
+			rec.NewSequence(camid = it->first);
+		}
+		rec.AddPoint(it->second);
+	}
+}
+
+/*
+ * @brief 一致性检查: 声明与单线程逐位一致的路径, 以合成数据比对
+ * @return
+ * 0: 全部一致; -3: 存在不一致
+ */
+static int bench_verify(int argc, char **argv) {
+	gen_param param;
+	param.dupframe = 2;	// 缺省包含时标相同的相邻帧
+	if (gen_options(argc, argv, param) != argc) {
+		printf("Usage: pvrec bench verify [options]\n");
+		gen_usage();
+		return -1;
+	}
+
+	// 合成数据写入临时文件: 并行解析及二进制转换需要可映射的文件
+	char pathRaw[] = "/tmp/pvverifyXXXXXX";
+	string pathBin, text;
+	int fd, nfail(0), ndiff, nlegacy;
+	generate(param, text);
+	if ((fd = mkstemp(pathRaw)) < 0) {
+		printf("failed to create temporary file\n");
+		return -2;
+	}
+	bool written = write(fd, text.data(), text.size()) == ssize_t(text.size());
+	close(fd);
+	pathBin = string(pathRaw) + ".pvb";
+
+	bench_points ref, pts;
+	if (!written || !verify_load(pathRaw, ref, nlegacy)) {
+		printf("failed to write or read %s\n", pathRaw);
+		unlink(pathRaw);
+		return -2;
+	}
+	printf("points: %d\n", int(ref.size()));
+	printf("%-31s mismatched %d\n", "APVParser vs sscanf", nlegacy);
+	nfail += nlegacy != 0;
+
+	// 并行解析: 小区间使行边界落在区间边界附近
+	size_t chunks[] = {4096, APVChunkParser::CHUNK_SIZE};
+	for (int i = 0; i < 2; ++i) {
+		for (int nthread = 1; nthread <= 4; ++nthread) {
+			char title[64];
+			pts.clear();
+			ndiff = verify_chunks(pathRaw, nthread, chunks[i], pts) ? diff_points(ref, pts) : -1;
+			snprintf(title, sizeof(title), "APVChunkParser -p %d, %zu B", nthread, chunks[i]);
+			printf("%-31s mismatched %d\n", title, ndiff);
+			nfail += ndiff != 0;
+		}
+	}
+
+	pts.clear();
+	ndiff = verify_binary(pathRaw, pathBin.c_str(), pts) ? diff_points(ref, pts) : -1;
+	printf("%-31s mismatched %d\n", "APVBinary", ndiff);
+	nfail += ndiff != 0;
+	unlink(pathBin.c_str());
+	unlink(pathRaw);
+
+	// 识别: 网格索引与逐一比对的原算法结果一致
+	param_pv pvparam;
+	string text1, textn, legacy;
+	std::vector<PPVOBJ> objs1, objsn;
+	pvparam.triplet = param.window == 3;
+	if (pvparam.triplet) printf("%-31s skipped (-w 3)\n", "APVRec vs brute force");
+	else {
+		APVRec rec;
+		legacy_rec rec0;
+		verify_sequences(rec, ref, pvparam, textn);
+		verify_sequences(rec0, ref, pvparam, legacy);
+		printf("%-31s %s\n", "APVRec vs brute force", textn == legacy ? "identical" : "DIFFERENT");
+		nfail += textn != legacy;
+	}
+	// 识别: 多线程输出与单线程逐字节一致
+	verify_recognize(ref, 1, pvparam, text1, objs1);
+	for (int nthread = 2; nthread <= 4; nthread *= 2) {
+		char title[64];
+		textn.clear();
+		objsn.clear();
+		verify_recognize(ref, nthread, pvparam, textn, objsn);
+		snprintf(title, sizeof(title), "APVDemux -j %d (%d objects)", nthread, int(objsn.size()));
+		printf("%-31s %s\n", title, textn == text1 ? "identical" : "DIFFERENT");
+		nfail += textn != text1;
+	}
+
+	// 格式化: APVFormat与snprintf()逐字节一致
+	APVFormat format;
+	ndiff = 0;
+	for (std::vector<PPVOBJ>::iterator it = objs1.begin(); it != objs1.end(); ++it) {
+		legacy.clear();
+		legacy_format(**it, legacy);
+		format.Clear();
+		format.Object(**it);
+		if (legacy.size() != format.Size() || memcmp(legacy.data(), format.Data(), legacy.size())) ++ndiff;
+	}
+	printf("%-31s mismatched %d of %d objects\n", "APVFormat vs snprintf", ndiff, int(objs1.size()));
+	nfail += ndiff != 0;
+
+	printf("verify: %s\n", nfail ? "FAILED" : "passed");
+	return nfail ? -3 : 0;
+}
+
+int BenchMain(int argc, char **argv) {
+	if (argc < 1) {
+		printf("Usage: pvrec bench <item> [arguments]\n");
+		printf("item:\n");
+		printf("  parse <RAW file> [repeat]\n");
+		printf("  format [rows]\n");
+		printf("  gen <RAW file> [options]\n");
+		printf("  suite [options]\n");
+		printf("  sweep [options]\n");
+		printf("  verify [options]\n");
+		gen_usage();
+		return -1;
+	}
+	if (strcmp(argv[0], "parse") == 0) return bench_parse(argc - 1, argv + 1);
+	if (strcmp(argv[0], "format") == 0) return bench_format(argc - 1, argv + 1);
+	if (strcmp(argv[0], "gen") == 0)    return bench_gen(argc - 1, argv + 1);
+	if (strcmp(argv[0], "suite") == 0)  return bench_suite(argc - 1, argv + 1);
+	if (strcmp(argv[0], "sweep") == 0)  return bench_sweep(argc - 1, argv + 1);
+	if (strcmp(argv[0], "verify") == 0) return bench_verify(argc - 1, argv + 1);
+
+	printf("undefined bench item: %s\n", argv[0]);
+	return -1;
+}
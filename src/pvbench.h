@@ -0,0 +1,38 @@
+/*
+ * @file pvbench.h 性能测试
+ * @version 0.1
+ * @date Oct 17, 2026
+ *
+ * @note
+ * 使用方法:
+ *   pvrec bench <item> [arguments]
+ * 测试项:
+ *   parse <RAW file> [repeat]: 原始数据解析吞吐量, 对比sscanf()与APVParser
+ *   format [rows]: 目标输出格式化吞吐量, 对比snprintf()与APVFormat. 缺省1000000行
+ *   gen <RAW file> [options]: 生成合成数据文件, 格式与原始数据文件相同
+ *   suite [options]: 合成数据各阶段(解析/识别/输出)吞吐量. 识别调用APVRec::AddPoint()/EndSequence();
+ *                    定义PVREC_PROFILE编译时, 识别另按create/append/recheck/complete细分
+ *   sweep [options]: 恒星数量依次为-s参数的1/4~4倍时的各阶段吞吐量
+ *   verify [options]: 一致性检查. 以合成数据比对各路径与单线程参照路径的结果, 不一致时返回非零:
+ *                     APVParser与sscanf(), APVChunkParser(-p 1~4), APVBinary转换,
+ *                     APVRec与逐一比对的原关联算法, APVDemux(-j 2/4), APVFormat与snprintf().
+ *                     缺省-u 2, 即包含时标相同的相邻帧
+ * 合成数据参数:
+ *   -s 每台相机的恒星数量(300), -m 运动目标数量(30), -c 相机数量(2), -f 帧数(80),
+ *   -v 运动目标最大速度(20像素/帧), -n 位置噪声(0.1像素), -d 运动目标丢帧概率(0.1),
+ *   -t 帧间隔(10秒), -r 随机数种子(1), -u 沿用前一帧时标的帧编号(0: 无)
+ */
+
+#ifndef PVBENCH_H_
+#define PVBENCH_H_
+
+/*!
+ * @brief 性能测试入口
+ * @param argc 参数数量, 不含"pvrec bench"
+ * @param argv 参数列表, 不含"pvrec bench"
+ * @return
+ * 0: 成功; 其它: 失败
+ */
+int BenchMain(int argc, char **argv);
+
+#endif /* PVBENCH_H_ */
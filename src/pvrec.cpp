@@ -7,9 +7,36 @@
  Note        :
  - 使用方法:
    pvrec <parameter> <RAW file / RAW directory> <Result Directory>
+   pvrec bench <item> [arguments]: 性能测试, 见pvbench.h
+   pvrec convert <RAW file> <BIN file>: 将文本格式原始文件转换为二进制数据点文件, 见APVBinary.h
+   pvrec explode <packed directory> <result directory>: 将合并输出还原为逐目标文件
    参数列表:
-   -F 或缺省: 原始数据格式为文件
-   -D      : 原始数据格式为目录, 需遍历处理目录下扩展名为txt的文件
+   -F 或缺省: 原始数据格式为文件. 文件可以是管道/FIFO, "-"表示标准输入
+   -D      : 原始数据格式为目录, 需遍历处理目录下扩展名为txt或pvb的文件
+   -j N    : 使用N个工作线程并行识别不同相机. 缺省为1
+   -p N    : 使用N个线程并行解析单个原始文件. 缺省为1. 仅用于可映射的文本文件, 结果与单线程逐位一致
+   --idle <S>: 相机空闲时限, 量纲: 秒(数据时间), 应大于帧间隔. 相机超过时限无数据时结束其批次.
+              缺省为0, 仅在文件结束时结束
+   --stream: 流模式. 逐行读取文件、FIFO或标准输入, 目标被确认后立即输出. 忽略-j
+   --pack  : 合并输出. 所有目标写入结果目录中的objects.dat, 并以objects.idx索引, 见APVPack.h
+   --latency: 每个相机批次结束后输出单帧处理时间的p50/p99/max, 程序结束前输出各相机汇总
+   --deadline <S>: 单帧处理时限, 量纲: 秒, 统计超时帧数并启用--latency. 负数表示以帧间隔为时限
+   --dedup : 候选体去重. 末端两点相同的候选体仅保留数据点较多者, 避免同一轨迹输出为重复目标.
+             改变识别结果(目标数量可能减少), 缺省关闭
+   --triplet: 三帧确认. 相邻两帧的数据点对外推至下一帧并找到匹配数据点后, 才建立候选体.
+              适用于密集星场; 不再为缺失一帧的目标建立候选体
+   --reorder N: 乱序输入容错. 每个相机缓存至多N帧, 按帧编号组合数据点后按时标次序释放.
+              早于已释放帧的数据点被丢弃
+   --reorder-window <S>: 重排时间窗口, 量纲: 秒(数据时间). 帧时标早于最新时标S秒以上时释放,
+              限制重排引入的延迟. 可与--reorder同时使用, 任一条件满足即释放
+   --stats : 程序结束前输出流水线各队列的深度及生产者/消费者等待统计, 用于判断瓶颈阶段. 忽略于流模式
+   --trace <JSON file>: 记录文件、相机批次、帧处理各阶段及输出的时间线, 格式为Chrome trace-event
+ - 说明:
+   二进制数据点文件依据文件标志自动识别
+  不同相机的数据点可以交错, 由APVDemux按相机分流至各自的识别实例
+   文件模式下, 解析、识别、输出构成三段流水线, 以无锁队列交付: 数据点按帧, 识别结果按相机批次
+  识别结果由后台线程写入, 程序结束前等待写入完成并同步至磁盘
+   编译时定义PVREC_PROFILE, 每个原始文件处理结束后输出分阶段计时与计数汇总
  - 功能:
    关联不同时间的数据点, 从中提取位置变化源
 
@@ -29,177 +56,613 @@
 #include <string.h>
 #include <strings.h>
 #include <sys/time.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <map>
 #include <boost/filesystem.hpp>
 #include <boost/make_shared.hpp>
+#include <boost/bind/bind.hpp>
 #include "APVRec.h"
+#include "APVBinary.h"
+#include "APVChannel.h"
+#include "APVChunkParser.h"
+#include "APVDemux.h"
+#include "APVFormat.h"
+#include "APVPack.h"
+#include "APVParser.h"
+#include "APVReader.h"
+#include "APVTrace.h"
+#include "APVWriter.h"
 #include "ATimeSpace.h"
+#include "pvbench.h"
 
 using std::string;
 using namespace AstroUtil;
+using namespace boost::placeholders;
 
-ATimeSpace ats; // 全局变量, 唯一访问接口
+#define FRAME_QUEUE		64	//< 解析阶段与识别阶段之间的队列容量, 量纲: 帧
 
-/*
- * @brief 解析存储原始数据的文件中的一行信息
- * 文件行格式为:
- * - 第一行: 注释, 解释每一列的涵义
- * - 第二行至结束, 各列依次为:
- * UTC(精度到秒), 帧编号, X, Y, ra, dec, mag, mag_error, 亚秒(微秒), 天区编号
- */
-PPVPT resolve_line(const char* line, int &camid) {
-	int iy, im, id, hh, mm, ss, mics;
-	double errmag;
-	PPVPT pt = boost::make_shared<pv_point>();
-
-	// 格式要求(要求)
-	sscanf(line, "%d-%d-%d %d:%d:%d, %d, %lf, %lf, %lf, %lf, %lf, %lf, %d, %d",
-			&iy, &im, &id, &hh, &mm, &ss, &pt->fno,
-			&pt->x, &pt->y, &pt->ra, &pt->dc,
-			&pt->mag, &errmag, &mics, &camid);
-	ats.SetUTC(iy, im, id,
-			(hh + (mm + (ss + mics * 1E-6 + 5.0) / 60.0) / 60.0) / 24.0);
-	pt->mjd = ats.ModifiedJulianDay();
-	return pt;
+APVPack packer;	//< 合并输出. 未打开时逐目标输出文件
+bool latency(false);	//< 输出单帧处理延迟统计
+std::map<int, PVLATENCY> latcam;	//< 各相机的单帧处理延迟统计
+
+/*!
+ * @brief 输出单帧处理延迟统计
+ * @param title 标题
+ * @param lat   延迟统计
+ */
+void PrintLatency(const char *title, const PVLATENCY &lat) {
+	const APVHist &h = lat.hist;
+	printf("%s camera %03d: frames %lu, p50 %lu us, p99 %lu us, max %lu us, mean %.0f us, overrun %ld\n",
+			title, lat.camid, (unsigned long) h.Count(), (unsigned long) h.Percentile(50.0),
+			(unsigned long) h.Percentile(99.0), (unsigned long) h.Max(), h.Mean(), lat.overrun);
 }
 
-void Days2HMS(double fd, int &hh, int &mm, double &ss) {
-	hh = (int) fd;
-	fd = (fd - hh) * 60.0;
-	mm = (int) fd;
-	ss = (fd - mm) * 60.0;
+/*!
+ * @brief 记录并输出一个批次的单帧处理延迟统计
+ */
+void CollectLatency(const PVLATENCY &lat) {
+	if (!latency) return;
+	PrintLatency("latency", lat);
+	PVLATENCY &total = latcam[lat.camid];
+	total.camid = lat.camid;
+	total += lat;
 }
 
+
 /*!
- * @brief 输出已关联识别目标
- * @param pvrec  关联识别算法接口
+ * @brief 输出一个已关联识别目标
+ * @param camid  相机编号
+ * @param sn     目标在批次中的序号, 从1开始
+ * @param obj    已识别目标
  * @param dirDst 输出数据存储目录
- * @return
- * 导出目标的数量
+ * @param text   文件内容缓冲区. 由调用线程独占
  */
-int OutputObjects(APVRec *pvrec, const char *dirDst) {
+void OutputObject(int camid, int sn, const PPVOBJ &obj, const char *dirDst, APVFormat &text) {
 	namespace fs = boost::filesystem;
 	char filename[50];
-	int camid;
-	PPVOBJVEC & objs = pvrec->GetObject(camid);
-	PPVPT pt;
-	int iy, im, id, hh, mm, n(0);
-	double ss, fd;
+	int iy, im, id;
+	double fd;
 	FILE *fpdst;
 	fs::path path;
+	PPVPTVEC &pts = obj->pts;
 
-	for (PPVOBJVEC::iterator it = objs.begin(); it != objs.end(); ++it) {
-		PPVOBJ obj = *it;
-		PPVPTVEC &pts = obj->pts;
-
-//		// 筛选同步带目标
-//		bool is_valid(true);
-//		for (PPVPTVEC::iterator i = pts.begin(); i != pts.end() && is_valid; ++i) {
-//			is_valid = (*i)->dc > -16.0 && (*i)->dc < 0.0;
-//		}
-//		if (!is_valid) continue;
-
-		// 生成文件路径
-		ats.Mjd2Cal(pts[0]->mjd, iy, im, id, fd);
-		sprintf(filename, "%d%02d%02d_%03d_%04d.txt",
-				iy, im, id, camid, ++n);
+//	// 筛选同步带目标
+//	bool is_valid(true);
+//	for (PPVPTVEC::iterator i = pts.begin(); i != pts.end() && is_valid; ++i) {
+//		is_valid = (*i)->dc > -16.0 && (*i)->dc < 0.0;
+//	}
+//	if (!is_valid) return;
+
+	// 生成文件路径
+	ATimeSpace::Mjd2Cal(pts[0]->mjd, iy, im, id, fd);
+	sprintf(filename, "%d%02d%02d_%03d_%04d.txt",
+			iy, im, id, camid, sn);
+	printf(">>>> %s\n", filename);
+	APVTraceScope trace("write_object", camid, pts[0]->fno, filename);
+	// 写入文件内容
+	text.Clear();
+	text.Object(*obj);
+	if (packer.IsOpen()) packer.Append(filename, text.Data(), text.Size());
+	else {
 		path = dirDst;
 		path /= filename;
-		fpdst = fopen(path.c_str(), "w");
-		printf(">>>> %s\n", filename);
-		// 写入文件内容
-		for (PPVPTVEC::iterator i = pts.begin(); i != pts.end(); ++i) {
-			pt = *i;
-			ats.Mjd2Cal(pt->mjd, iy, im, id, fd);
-			Days2HMS(fd * 24.0, hh, mm, ss);
-			fprintf(fpdst, "%d %02d %02d %02d %02d %06.3f %4d %9.5f %9.5f ",
-					iy, im, id, hh, mm, ss, pt->fno, pt->ra, pt->dc);
-			if (pt->mag > 20.0) fprintf(fpdst, "99.99\r\n");
-			else fprintf(fpdst, "%5.2f\r\n", pt->mag);
+		if ((fpdst = fopen(path.c_str(), "wb"))) {
+			fwrite(text.Data(), 1, text.Size(), fpdst);
+			fclose(fpdst);
 		}
+	}
+}
+
+/*!
+ * @brief 输出已关联识别目标
+ * @param camid  相机编号
+ * @param objs   已识别目标
+ * @param dirDst 输出数据存储目录
+ * @param text   文件内容缓冲区. 由调用线程独占
+ * @return
+ * 导出目标的数量
+ */
+int OutputObjects(int camid, PPVOBJVEC &objs, const char *dirDst, APVFormat &text) {
+	APVTraceScope trace("output", camid);
+	int n(0);
 
-		fclose(fpdst);
+	for (PPVOBJVEC::iterator it = objs.begin(); it != objs.end(); ++it) {
+		OutputObject(camid, ++n, *it, dirDst, text);
 	}
 	printf("%d objects found\n", n);
 	return n;
 }
 
+/*!
+ * @brief 按结束次序将已完成识别的批次提交给异步输出接口
+ * @param demux  相机分流接口
+ * @param writer 异步输出接口
+ * @param wait   是否等待所有批次完成识别
+ * @param prof   累加批次的性能分析数据
+ * @return
+ * 提交目标的数量
+ */
+int FlushSequences(APVDemux &demux, APVWriter &writer, bool wait, PVPROFILE *prof = NULL) {
+	int objcnt(0);
+	PPVSEQ seq;
+
+	while ((seq = demux.Next(wait)).use_count()) {
+		if (prof) *prof += seq->prof;
+		CollectLatency(seq->lat);
+		objcnt += writer.Push(seq->camid, seq->objs); // 交由后台线程导出关联识别数据
+	}
+	return objcnt;
+}
+
+/*
+ * @brief 输出性能分析汇总
+ * @param title 标题: 文件路径
+ * @param prof  性能分析数据
+ */
+void PrintProfile(const char *title, const PVPROFILE &prof) {
+	printf("==== profile: %s ====\n", title);
+	printf("%-10s %10s %12s %12s\n", "stage", "calls", "time(ms)", "us/call");
+	for (int i = 0; i < PVSTAGE_MAX; ++i) {
+		printf("%-10s %10ld %12.3f %12.3f\n", PVPROFILE::StageName(i), prof.calls[i],
+				prof.elapse[i] * 1E3, prof.calls[i] ? prof.elapse[i] * 1E6 / prof.calls[i] : 0.0);
+	}
+	printf("candidates: created %ld, extended %ld, promoted %ld, discarded %ld, merged %ld, unconfirmed %ld, peak %d\n",
+			prof.created, prof.extended, prof.promoted, prof.discarded, prof.merged, prof.unconfirmed, prof.cansmax);
+	if (prof.reordered || prof.late)
+		printf("reorder: %ld frames released out of arrival order, %ld late points dropped\n", prof.reordered, prof.late);
+	printf("frames: %ld, points: %ld, peak points per frame: %d\n",
+			prof.frames, prof.points, prof.frmptmax);
+}
+
+/*
+ * @brief 输出流水线队列统计
+ */
+void PrintChannel(const PVCHANSTAT &stat) {
+	printf("queue %-17s capacity %3d, pushed %8lu, depth mean %6.1f max %3lu, "
+			"producer stalls %6lu (%9.3f ms), consumer stalls %6lu (%9.3f ms)\n",
+			stat.name, stat.capacity, stat.pushed, stat.DepthMean(), stat.depthmax,
+			stat.fullstall, stat.fullwait * 1E3, stat.emptystall, stat.emptywait * 1E3);
+}
+
+typedef struct pv_frame_batch {// 解析阶段交付识别阶段的数据: 同一相机同一帧的数据点, 或文件结束标志
+	int camid;		//< 相机编号
+	std::vector<PVPT> pts;	//< 数据点
+	string endfile;	//< 非空时为文件结束标志, 值为文件路径
+}PVFRMBATCH;
+typedef boost::shared_ptr<PVFRMBATCH> PPVFRMBATCH;
+typedef APVChannel<PPVFRMBATCH> PVFRMCHANNEL;
+
+/*
+ * @brief 流水线第一阶段: 解析. 在主线程中运行, 将数据点按帧组合后交付识别阶段
+ */
+struct parse_stage {
+	PVFRMCHANNEL &chan;	//< 交付识别阶段的队列
+	PPVFRMBATCH batch;	//< 正在组合的帧
+	int fno;			//< 正在组合的帧编号
+	size_t reserve;		//< 新建帧预留的数据点数量: 前一帧的数据点数量
+	int nthread;		//< 单个原始文件的解析线程数量
+
+public:
+	parse_stage(PVFRMCHANNEL &Chan, int Nthread = 1) : chan(Chan) {
+		fno     = -1;
+		reserve = 256;
+		nthread = Nthread;
+	}
+
+	void AddPoint(int camid, const PVPT &pt) {
+		if (batch.use_count() && (camid != batch->camid || pt.fno != fno)) Flush();
+		if (!batch.use_count()) {
+			batch = boost::make_shared<PVFRMBATCH>();
+			batch->camid = camid;
+			batch->pts.reserve(reserve);
+			fno = pt.fno;
+		}
+		batch->pts.push_back(pt);
+	}
+
+	void EndFile(const char *filepath) {// 文件结束: 识别阶段结束所有相机批次
+		Flush();
+		batch = boost::make_shared<PVFRMBATCH>();
+		batch->camid   = -1;
+		batch->endfile = filepath;
+		chan.Push(batch);
+		batch.reset();
+	}
+
+	void Flush() {
+		if (batch.use_count()) {
+			reserve = batch->pts.size();
+			chan.Push(batch);
+			batch.reset();
+		}
+	}
+};
+
+/*
+ * @brief 流水线第二阶段: 识别. 在独立线程中运行, 由APVDemux分流至各相机的识别实例,
+ * 已结束的批次交由流水线第三阶段(APVWriter后台线程)导出
+ */
+struct recognize_stage {
+	PVFRMCHANNEL &chan;	//< 来自解析阶段的队列
+	APVDemux &demux;	//< 相机分流接口
+	APVWriter &writer;	//< 异步输出接口
+	int objcnt;			//< 提交导出的目标数量
+	PVPROFILE prof;		//< 当前文件的性能分析数据
+
+public:
+	recognize_stage(PVFRMCHANNEL &Chan, APVDemux &Demux, APVWriter &Writer)
+		: chan(Chan), demux(Demux), writer(Writer) {
+		objcnt = 0;
+	}
+
+	void Run() {
+		PPVFRMBATCH batch;
+
+		APVTrace::SetThreadName("recognize");
+		while (chan.Pop(batch)) {
+			if (batch->endfile.size()) {
+				demux.End();
+				objcnt += FlushSequences(demux, writer, false, &prof);
+#ifdef PVREC_PROFILE
+				objcnt += FlushSequences(demux, writer, true, &prof); // 等待本文件的所有批次, 使汇总完整
+				PrintProfile(batch->endfile.c_str(), prof);
+				prof.Reset();
+#endif
+				continue;
+			}
+			// 按相机分流. 空闲超时的批次已结束时, 导出其结果
+			int camid = batch->camid;
+			for (std::vector<PVPT>::iterator it = batch->pts.begin(); it != batch->pts.end(); ++it) {
+				if (demux.AddPoint(camid, *it)) objcnt += FlushSequences(demux, writer, false, &prof);
+			}
+		}
+	}
+};
+
+/*
+ * @brief 流水线第三阶段: 输出. 由APVWriter后台线程调用
+ */
+struct write_stage {
+	string dirDst;	//< 结果文件目录
+	APVFormat text;	//< 文件内容缓冲区, 仅由后台线程使用
+
+public:
+	write_stage(const char *dir) : dirDst(dir) {
+	}
+
+	int Export(int camid, PPVOBJVEC &objs) {
+		return OutputObjects(camid, objs, dirDst.c_str(), text);
+	}
+};
+
+/*
+ * @brief 处理一个二进制数据点文件
+ * @param stage   解析阶段
+ * @param pathBin 二进制文件路径
+ * @return
+ * 数据点数量. 失败时为-1
+ */
+int ProcessBinary(parse_stage &stage, const char *pathBin) {
+	APVTraceScope trace("file", -1, -1, pathBin);
+	APVBinary bin;
+	const PVBINREC *rec, *recend;
+	int npt(0), i, n;
+	PVPT pt;
+
+	if (!bin.Open(pathBin)) {
+		printf("invalid binary file: %s\n", pathBin);
+		return -1;
+	}
+	for (i = 0, n = bin.SequenceCount(); i < n; ++i) {// 逐条转换映射内存中的记录
+		const PVBINSEQ &seq = bin.Sequence(i);
+		for (rec = bin.Records(seq.firstrec), recend = rec + seq.nrec; rec != recend; ++rec) {
+			APVBinary::ToPoint(*rec, pt);
+			stage.AddPoint(seq.camid, pt);
+		}
+		npt += seq.nrec;
+	}
+	stage.EndFile(pathBin);
+
+	return npt;
+}
+
+/*
+ * @brief 多线程解析一个原始文件, 按文件次序交付解析阶段
+ * @param stage   解析阶段
+ * @param chunker 已打开原始文件的并行解析接口
+ * @param pathRaw 原始文件路径
+ * @return
+ * 数据点数量
+ */
+int ProcessChunks(parse_stage &stage, APVChunkParser &chunker, const char *pathRaw) {
+	const PVCHUNK *chunk;
+	int npt(0), i, n;
+
+	while ((chunk = chunker.Next())) {
+		for (std::vector<std::pair<int, int> >::const_iterator it = chunk->errs.begin(); it != chunk->errs.end(); ++it)
+			printf("%s:%d: %s\n", pathRaw, it->first, APVParser::ErrorString(it->second));
+		for (i = 0, n = chunk->pts.size(); i < n; ++i) stage.AddPoint(chunk->cams[i], chunk->pts[i]);
+		npt += n;
+	}
+	chunker.Close();
+	stage.EndFile(pathRaw);
+
+	return npt;
+}
+
 /*
  * @brief 处理一个原始文件
+ * @param stage   解析阶段
  * @param pathRaw 原始文件路径
- * @param dirDst  结果文件目录
+ * @return
+ * 数据点数量. 失败时为-1
  */
-int ProcessFile(const char *pathRaw, const char *dirDst) {
-	FILE *fpraw;
-	char line[200];
-	int objcnt(0), newid(-1), oldid(-1);
-	APVRec pvrec;
+int ProcessFile(parse_stage &stage, const char *pathRaw) {
+	APVTraceScope trace("file", -1, -1, pathRaw);
+	APVReader reader;
+	const char *line, *end;
+	int npt(0), camid, rslt;
+	APVParser parser;
+	PVPT pt;
 
-	if ((fpraw = fopen(pathRaw, "r")) == NULL) {// 打开原始文件
+	if (strcmp(pathRaw, "-") && APVBinary::IsBinary(pathRaw))
+		return ProcessBinary(stage, pathRaw);
+	if (stage.nthread > 1 && strcmp(pathRaw, "-")) {// 可映射的普通文件: 多线程解析
+		APVChunkParser chunker(stage.nthread);
+		if (chunker.Open(pathRaw)) return ProcessChunks(stage, chunker, pathRaw);
+	}
+	if (!reader.Open(pathRaw)) {// 打开原始文件
 		printf("failed to open file: %s\n", pathRaw);
 		return -1;
 	}
 
-	fgets(line, 200, fpraw); // 空读一行
-	while (!feof(fpraw)) {// 遍历原始数据文件
-		if (fgets(line, 200, fpraw) == NULL) continue;
-		PPVPT pt = resolve_line(line, newid);
-
-		if (oldid != newid) {
-			if (oldid != -1) {
-				pvrec.EndSequence();
-				objcnt += OutputObjects(&pvrec, dirDst); // 导出关联识别数据
-			}
-			oldid = newid;
-			pvrec.NewSequence(newid);
+	reader.NextLine(line, end); // 空读一行
+	while (reader.NextLine(line, end)) {// 遍历原始数据文件
+		if ((rslt = parser.Resolve(line, end, pt, camid)) != APVParser::PARSE_OK) {
+			if (rslt != APVParser::PARSE_BLANK) // 报告并跳过格式错误的行
+				printf("%s:%d: %s\n", pathRaw, reader.LineNumber(), APVParser::ErrorString(rslt));
+			continue;
 		}
+		stage.AddPoint(camid, pt);
+		++npt;
+	}
+	reader.Close(); // 关闭原始文件
+	stage.EndFile(pathRaw);
+
+	return npt;
+}
+
+/*
+ * @brief 流模式输出: 目标被确认后立即写入结果文件
+ */
+struct stream_output {
+	string dirDst;	//< 结果文件目录
+	std::map<int, int> sn;	//< 各相机当前批次已输出目标数量
+	int total;		//< 已输出目标总数
+	APVFormat text;	//< 文件内容缓冲区
 
-		pvrec.AddPoint(pt);
+public:
+	stream_output(const char *dir) : dirDst(dir) {
+		total = 0;
 	}
-	fclose(fpraw); // 关闭原始文件
-	// 最好一行原始数据的特殊处理
-	pvrec.EndSequence();
-	objcnt += OutputObjects(&pvrec, dirDst); // 导出关联识别数据
 
-	return objcnt;
+	void OnObject(int camid, const PPVOBJ &obj) {
+		OutputObject(camid, ++sn[camid], obj, dirDst.c_str(), text);
+		++total;
+		fflush(stdout);
+	}
+
+	void EndSequence(int camid) {
+		printf("%d objects found\n", sn[camid]);
+		fflush(stdout);
+		sn.erase(camid);
+	}
+};
+
+/*
+ * @brief 流模式: 处理已结束的相机批次
+ */
+void EndStreamSequences(APVDemux &demux, stream_output &output, PVPROFILE &prof) {
+	PPVSEQ seq;
+
+	while ((seq = demux.Next(false)).use_count()) {
+		output.EndSequence(seq->camid);
+		prof += seq->prof;
+		CollectLatency(seq->lat);
+	}
+}
+
+/*
+ * @brief 流模式处理原始数据: 逐行读取标准输入或FIFO, 目标被确认后立即输出
+ * @param param   数据处理参数
+ * @param pathRaw 原始文件路径. "-"表示标准输入
+ * @param dirDst  结果文件目录
+ * @param idle    相机空闲时限, 量纲: 秒
+ * @return
+ * 导出目标的数量
+ */
+int ProcessStream(param_pv &param, const char *pathRaw, const char *dirDst, double idle) {
+	APVTraceScope trace("file", -1, -1, pathRaw);
+	APVReader reader;
+	APVParser parser;
+	APVDemux demux(1, param, idle);
+	stream_output output(dirDst);
+	PVPROFILE prof;
+	const char *line, *end;
+	int camid, rslt;
+	PVPT pt;
+
+	if (!reader.Open(pathRaw)) {
+		printf("failed to open file: %s\n", pathRaw);
+		return -1;
+	}
+	demux.RegisterObject(boost::bind(&stream_output::OnObject, &output, _1, _2));
+
+	reader.NextLine(line, end); // 空读一行
+	while (reader.NextLine(line, end)) {
+		if ((rslt = parser.Resolve(line, end, pt, camid)) != APVParser::PARSE_OK) {
+			if (rslt != APVParser::PARSE_BLANK)
+				printf("%s:%d: %s\n", pathRaw, reader.LineNumber(), APVParser::ErrorString(rslt));
+			continue;
+		}
+		if (demux.AddPoint(camid, pt)) EndStreamSequences(demux, output, prof);
+	}
+	demux.End();
+	EndStreamSequences(demux, output, prof);
+#ifdef PVREC_PROFILE
+	PrintProfile(pathRaw, prof);
+#endif
+
+	return output.total;
 }
 
 /*
  * @brief 处理一个原始文件目录
+ * @param stage   解析阶段
  * @param dirRaw  原始文件目录
- * @param dirDst  结果文件目录
+ * @return
+ * 数据点数量
+ * @note
+ * 按文件名次序处理, 保证输出与线程数量无关
  */
-int ProcessDirectory(const char *dirRaw, const char *dirDst) {
+int ProcessDirectory(parse_stage &stage, const char *dirRaw) {
 	namespace fs = boost::filesystem;
 
-	int objcnt(0), n;
+	int npt(0), n;
 	fs::path path = dirRaw;
 	fs::directory_iterator itend = fs::directory_iterator();
-	string extdef = ".txt", extname;
+	std::vector<fs::path> files;
+	string extname;
 	for (fs::directory_iterator x = fs::directory_iterator(path); x != itend; ++x) {
 		extname = x->path().filename().extension().string();
-		if (extname == extdef) {
-			printf("**** %s ****\n", x->path().filename().c_str());
-			n = ProcessFile(x->path().c_str(), dirDst);
-			if (n > 0) objcnt += n;
-		}
+		if (extname == ".txt" || extname == ".pvb") files.push_back(x->path());
 	}
+	std::sort(files.begin(), files.end());
 
-	return objcnt;
+	for (std::vector<fs::path>::iterator x = files.begin(); x != files.end(); ++x) {
+		printf("**** %s ****\n", x->filename().c_str());
+		n = ProcessFile(stage, x->c_str());
+		if (n > 0) npt += n;
+	}
+
+	return npt;
+}
+
+/*
+ * @brief 将结果目录所在文件系统的缓存写入磁盘
+ */
+void SyncDirectory(const char *dirDst) {
+#ifdef __linux__
+	int fd = open(dirDst, O_RDONLY);
+	if (fd >= 0) {
+		syncfs(fd);
+		close(fd);
+		return;
+	}
+#endif
+	sync();
 }
 
 int main(int argc, char** argv) {
-	if (argc < 3 || argc > 4) {
+	if (argc >= 2 && strcmp(argv[1], "bench") == 0) return BenchMain(argc - 2, argv + 2);
+	if (argc >= 2 && strcmp(argv[1], "explode") == 0) {
+		if (argc != 4) {
+			printf("Usage: pvrec explode <packed directory> <result directory>\n");
+			return -1;
+		}
+		int nobj = APVPack::Explode(argv[2], argv[3]);
+		if (nobj < 0) printf("failed to explode %s\n", argv[2]);
+		else printf("%d objects exploded\n", nobj);
+		return nobj < 0 ? -1 : 0;
+	}
+	if (argc >= 2 && strcmp(argv[1], "convert") == 0) {
+		if (argc != 4) {
+			printf("Usage: pvrec convert <RAW file> <BIN file>\n");
+			return -1;
+		}
+		long nrec = APVBinary::Convert(argv[2], argv[3]);
+		if (nrec < 0) printf("failed to convert %s\n", argv[2]);
+		else printf("%ld points converted\n", nrec);
+		return nrec < 0 ? -1 : 0;
+	}
+	if (argc < 3) {
 		printf("Usgae: pvrec <param> <path name of raw file> <directory name of result>\n");
 		return -1;
 	}
 	// 解析命令行参数
 	string paths[2];
 	int pos(0), type(0); // type: 0, File; 1: Directory
+	int nthread(1), nparse(1);
+	bool stream(false), pack(false), stats(false);
+	const char *pathTrace(NULL);
+	double deadline(0.0), idle(0.0);
+	bool dedup(false), triplet(false);
+	int reorder(0);
+	double reorderdt(0.0);
 	for (int i = 1; i < argc; ++i) {
-		if (argv[i][0] == '-') {
+		if (argv[i][0] == '-' && argv[i][1]) {// 单独的"-"表示标准输入
 			if (strcasecmp(argv[i], "-D") == 0) type = 1;
 			else if (strcasecmp(argv[i], "-F") == 0) type = 0;
+			else if (strcmp(argv[i], "--stream") == 0) stream = true;
+			else if (strcmp(argv[i], "--pack") == 0) pack = true;
+			else if (strcmp(argv[i], "--latency") == 0) latency = true;
+			else if (strcmp(argv[i], "--dedup") == 0) dedup = true;
+			else if (strcmp(argv[i], "--triplet") == 0) triplet = true;
+			else if (strcmp(argv[i], "--stats") == 0) stats = true;
+			else if (strcmp(argv[i], "--deadline") == 0) {
+				if (i + 1 >= argc) {
+					printf("--deadline requires seconds\n");
+					return -2;
+				}
+				deadline = atof(argv[++i]);
+				latency  = true;
+			}
+			else if (strcmp(argv[i], "--reorder") == 0) {
+				if (i + 1 >= argc || (reorder = atoi(argv[i + 1])) < 1) {
+					printf("--reorder requires positive frame number\n");
+					return -2;
+				}
+				++i;
+			}
+			else if (strcmp(argv[i], "--reorder-window") == 0) {
+				if (i + 1 >= argc || (reorderdt = atof(argv[i + 1])) <= 0.0) {
+					printf("--reorder-window requires positive seconds\n");
+					return -2;
+				}
+				++i;
+			}
+			else if (strcmp(argv[i], "--idle") == 0) {
+				if (i + 1 >= argc || atof(argv[i + 1]) < 0.0) {
+					printf("--idle requires non-negative seconds\n");
+					return -2;
+				}
+				idle = atof(argv[++i]);
+			}
+			else if (strcmp(argv[i], "--trace") == 0) {
+				if (i + 1 >= argc) {
+					printf("--trace requires file path\n");
+					return -2;
+				}
+				pathTrace = argv[++i];
+			}
+			else if (strncmp(argv[i], "-j", 2) == 0) {// -j N 或 -jN
+				const char *arg = argv[i][2] ? argv[i] + 2 : (i + 1 < argc ? argv[++i] : "");
+				if ((nthread = atoi(arg)) < 1) {
+					printf("invalid thread number\n");
+					return -2;
+				}
+			}
+			else if (strncmp(argv[i], "-p", 2) == 0) {// -p N 或 -pN
+				const char *arg = argv[i][2] ? argv[i] + 2 : (i + 1 < argc ? argv[++i] : "");
+				if ((nparse = atoi(arg)) < 1) {
+					printf("invalid parser thread number\n");
+					return -2;
+				}
+			}
 			else {
 				printf("undefined parameter\n");
 				return -2;
@@ -218,7 +681,11 @@ int main(int argc, char** argv) {
 	// 检查原始数据是否有效
 	namespace fs = boost::filesystem;
 	fs::path path = paths[0];
-	if (type == 0 && !fs::is_regular_file(path)) {
+	if (stream && type == 1) {
+		printf("stream mode requires file path\n");
+		return -4;
+	}
+	if (type == 0 && paths[0] != "-" && (!fs::exists(path) || fs::is_directory(path))) {
 		printf("RAW file requires file path\n");
 		return -4;
 	}
@@ -233,9 +700,54 @@ int main(int argc, char** argv) {
 		return -6;
 	}
 
+	if (pack && !packer.Open(paths[1].c_str())) {
+		printf("failed to open packed output in %s\n", paths[1].c_str());
+		return -7;
+	}
+
+	if (pathTrace) {
+		APVTrace::Enable();
+		APVTrace::SetThreadName("main");
+	}
+
 	int n;
-	if (type == 0) n = ProcessFile(paths[0].c_str(), paths[1].c_str());
-	else n = ProcessDirectory(paths[0].c_str(), paths[1].c_str());
+	param_pv param;
+	param.deadline = deadline;
+	param.latency  = latency;
+	param.dedup    = dedup;
+	param.triplet  = triplet;
+	param.reorder  = reorder;
+	param.reorderdt = reorderdt / DAYSEC;
+	if (stream) n = ProcessStream(param, paths[0].c_str(), paths[1].c_str(), idle);
+	else {
+		// 三段流水线: 解析(主线程) -> 识别 -> 输出(APVWriter后台线程)
+		write_stage write(paths[1].c_str());
+		APVWriter writer(boost::bind(&write_stage::Export, &write, _1, _2));
+		APVDemux demux(nthread, param, idle);
+		PVFRMCHANNEL chan("parse->recognize", FRAME_QUEUE);
+		recognize_stage recognize(chan, demux, writer);
+		parse_stage parse(chan, nparse);
+		boost::thread thrd(boost::bind(&recognize_stage::Run, &recognize));
+
+		if (type == 0) ProcessFile(parse, paths[0].c_str());
+		else ProcessDirectory(parse, paths[0].c_str());
+		chan.Close();
+		thrd.join();
+		n = recognize.objcnt + FlushSequences(demux, writer, true);
+		writer.Close();	// 等待所有目标写入
+		if (stats) {
+			PrintChannel(chan.Stat());
+			PrintChannel(writer.Stat());
+		}
+	}
+	if (pack) {
+		if (!packer.Close()) printf("failed to write packed output\n");
+	}
+	else SyncDirectory(paths[1].c_str());
+	for (std::map<int, PVLATENCY>::iterator it = latcam.begin(); it != latcam.end(); ++it) {
+		PrintLatency("latency total", it->second);
+	}
+	if (pathTrace && APVTrace::Write(pathTrace) < 0) printf("failed to write trace: %s\n", pathTrace);
 	printf("%d totally being correlated\n", n);
 	printf("---------- Over ----------\n");
 